@@ -1,10 +1,50 @@
 #include "agent.h"
+#include "book.h"
 #include "breakthrough.h"
 #include "eval.h"
+#include "tt.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <fstream>
+#include <utility>
+
+namespace {
+
+    /** Maximal number of plies searched by the quiescence search */
+    constexpr int qs_max_depth = 6;
+
+    /**
+     * Margin on top of a pawn's value under which a capture can't
+     * bring the score back above alpha in the quiescence search.
+     *
+     * NOTE: Covers the pawn-square value of the captured pawn plus
+     * the structural bonuses that can change with one capture
+     */
+    constexpr int delta_margin = 80;
+
+    /** Relative row from which a pawn push is considered a promotion threat */
+    constexpr int threat_row = 5;
+
+    /** Number of nodes the endgame solver may expand before giving up */
+    constexpr long long solver_node_budget = 100000;
+
+    /** Time the endgame solver may take, a quarter of the 100 ms turn */
+    constexpr std::chrono::milliseconds solver_time_budget{ 25 };
+
+    /** Bring the transposition table move at the front if it is in [beg, end) */
+    template<typename Iter>
+    void put_first(Iter beg, Iter end, const Move& move) {
+        if (move == Move_None)
+            return;
+        auto it = std::find(beg, end, move);
+        if (it != end)
+            std::iter_swap(beg, it);
+    }
+
+}  // namespace
 
     Agent::Agent(Game& _game)
         : game(_game)
@@ -12,9 +52,19 @@
         move_buf.reserve(max_n_moves);
     }
 
-    // To be called right after turn_init
+    void Agent::set_helper(const std::atomic<bool>* _stop) {
+        stop = _stop;
+    }
+
+    bool Agent::stopped() const {
+        return stop && stop->load(std::memory_order_relaxed);
+    }
+
+    // NOTE: The valid moves are recomputed since a previous search
+    // leaves those of the last node it visited in the game
     void Agent::make_root() {
         root_moves.clear();
+        game.compute_valid_moves();
         auto [beg, end] = game.valid_moves();
         std::transform(beg, end, std::back_inserter(root_moves), [](const auto& m){
             return ExtMove(m);
@@ -76,31 +126,84 @@
         //
         // BASIC IDEA: When overwriting a value in the root_nodes, also save the best follow-up move
         // if it is available as member data of the Agent class.
+        //
+        // UPDATE: Win scores are now penalized by the ply at which they occur and the best
+        // follow-up move of every node is kept in the transposition table (see tt.h), which
+        // iterative deepening also uses to search the previous best line first.
+
+        // Opening moves were searched offline (see book_gen.cpp)
+        if (Move move = Book::probe(game); move != Move_None) {
+            std::cerr << "book move: " << Game::view_move(move) << std::endl;
+            return move;
+        }
+
+        // Pawn races need exact results: try to prove a win before searching
+        if (Solver::applicable(game)) {
+            Solver::Result res = solver.solve(game, solver_node_budget,
+                                              Solver::Clock::now() + solver_time_budget);
+
+            std::cerr << "solver: "
+                << (res.status == Solver::Status::Win ? "win"
+                    : res.status == Solver::Status::Loss ? "loss"
+                    : "unknown")
+                << " nodes: " << res.nodes
+                << std::endl;
+
+            if (res.status == Solver::Status::Win)
+                return res.move;
+        }
+
+        TT.new_search();
+
+        return iterative_deepening(0, s_depth, s_width);
+    }
+
+    Move Agent::iterative_deepening(int start_depth, int s_depth, int s_width)
+    {
+        make_root();
 
         Stack stack[max_depth];
         Stack* ss = &stack[0];
         ss->depth = 0;
         n_evals = 0;
+        n_tt_probes = 0;
+        n_tt_hits = 0;
+        m_completed_depth = -1;
+        m_best_score = -value_win - 1;
 
-        int alpha = -100;
-        int beta = 100;
+        for (int depth = start_depth; depth <= s_depth; ++depth) {
 
-        Move previous_best_move = root_moves[0];
-        int previous_best_score = -32001;
+            int alpha = -value_win - 1;
+            int beta = value_win + 1;
 
-        for (int depth = 0; depth < s_depth; ++depth) {
+            for (auto& rm : root_moves)
+                rm.value = -value_win - 1;
 
             //int best_score = simple_eval_minimax(s_depth, ss);
-            int best_score = eval_minimax(alpha, beta, s_depth, s_width, ss);
-
-            std::cerr << "depth " << depth
-                << " score: " << best_score
-                << std::endl;
+            int best_score = eval_minimax(alpha, beta, depth, s_width, ss);
+
+            // The root moves are only sorted after a completed iteration, so
+            // root_moves[0] is still the best move of the previous one
+            if (stopped())
+                break;
+
+            if (!stop) {
+                std::cerr << "depth " << depth
+                    << " score: " << best_score
+                    << " nodes: " << n_evals
+                    << std::endl;
+            }
 
             std::stable_sort(root_moves.begin(), root_moves.end());
 
             assert(root_moves[0].value == best_score);
 
+            m_completed_depth = depth;
+            m_best_score = best_score;
+
+            // No need to look further if we found a forced win
+            if (best_score >= value_win_in_max_ply)
+                break;
         }
         return root_moves[0];
     }
@@ -186,18 +289,40 @@
 
     /**
      * The main alpha beta minimax method
+     *
+     * NOTE: The leaves are resolved by the quiescence search, so the
+     * remaining depth of a node is s_depth + 1 when it comes to the
+     * transposition table (0 being reserved for quiescence results).
      */
     int Agent::eval_minimax(int alpha, int beta, int s_depth, int s_width, Stack* ss)
     {
         const bool at_root = ss->depth == 0;
         ++n_evals;
 
+        if (stopped())
+            return 0;
+
         bool won_game = game.player_to_move() == Player::White
             ? game.has_won<Player::Black>()
             : game.has_won<Player::White>();
 
         if (won_game) {
-            return at_root ? 32000 : -32000;
+            return at_root ? value_win : -value_win + ss->depth;
+        }
+
+        const Key key = game.key();
+        TTData tte;
+        const bool tt_hit = TT.probe(key, tte);
+        ++n_tt_probes;
+        n_tt_hits += tt_hit;
+
+        if (!at_root && tt_hit && tte.depth >= s_depth + 1) {
+            int tt_value = value_from_tt(tte.value, ss->depth);
+
+            if (tte.bound == Bound::Exact
+                || (tte.bound == Bound::Lower && tt_value >= beta)
+                || (tte.bound == Bound::Upper && tt_value <= alpha))
+                return tt_value;
         }
 
         std::array<Move, max_n_moves> moves;
@@ -211,6 +336,10 @@
         const int n_moves = std::distance(beg, end);
         assert(n_moves > 0);
 
+        if (tt_hit)
+            put_first(moves.begin(), moves.begin() + n_moves, tte.move);
+
+        const int alpha_orig = alpha;
         int best_score = -32001;
         Move best_move = Move_None;
         ss->move_count = 0;
@@ -222,22 +351,21 @@
             int score = best_score;
 
             game.apply(*it, st);
-            if (s_depth == 0) {
-                score = -Eval::evaluate(game);
 
-                // Adjust scores with a penalty for winning moves that are deep into the tree
-                if (score >= 32000 - max_depth)
-                    score -= ss->depth;
+            // Resolve the captures and promotion threats before evaluating
+            if (s_depth == 0)
+                score = -qsearch(-beta, -alpha, qs_max_depth, ss + 1);
 
-                else if (score <= -32000 + max_depth)
-                    score += ss->depth;
-            }
             // General depth
             else
                 score = -eval_minimax(-beta, -alpha, s_depth - 1, s_width, ss + 1);
 
             game.undo(*it);
 
+            // The result of an aborted search is meaningless
+            if (stopped())
+                return 0;
+
             assert( -32001 < score  && score < 32001 );
 
             // Finished searching a branch, update the search results
@@ -266,19 +394,157 @@
             }
         }
         // Went through all moves now
-        // TODO: Save the best move to some kind of pv history
         //
         // NOTE: We could make the necessary checks for when there was no moves available here.
         // Be there that there's a bug or the game is already won. In Stockfish, they also update
         // meta-search statistics here since in case the search failed to prune this node even though
         // there is no move available, it is often because of critical events in the game.
         // This is why it's so useful to have a `move_count` variable in the search stack.
-        // It would also be useful to keep track of a principal variation in order to always start
-        // with the best line so far.
         //
         // NOTE: A relevant node having only one child (say move_count == 1 here) can be
         // contracted into the edge to its parent. In Stockfish it seems to be the
         // `continuation history`
 
+        Bound bound = best_score >= beta ? Bound::Lower
+            : best_score > alpha_orig ? Bound::Exact
+            : Bound::Upper;
+
+        TT.store(key, value_to_tt(best_score, ss->depth), bound, s_depth + 1, best_move);
+
+        return best_score;
+    }
+
+    /**
+     * Quiescence search
+     *
+     * Only captures and pushes reaching the last ranks are searched so that
+     * the static evaluation is only ever called on quiet positions. The side
+     * to move can always `stand pat', i.e. decline to play any of those moves,
+     * unless the opponent has a pawn one step away from promoting, in which case
+     * it has to be captured right away.
+     */
+    int Agent::qsearch(int alpha, int beta, int qdepth, Stack* ss)
+    {
+        ++n_evals;
+
+        if (stopped())
+            return 0;
+
+        const Player us = game.player_to_move();
+
+        bool won_game = us == Player::White
+            ? game.has_won<Player::Black>()
+            : game.has_won<Player::White>();
+
+        if (won_game)
+            return -value_win + ss->depth;
+
+        const Key key = game.key();
+        TTData tte;
+        const bool tt_hit = TT.probe(key, tte);
+        ++n_tt_probes;
+        n_tt_hits += tt_hit;
+
+        if (tt_hit) {
+            int tt_value = value_from_tt(tte.value, ss->depth);
+
+            if (tte.bound == Bound::Exact
+                || (tte.bound == Bound::Lower && tt_value >= beta)
+                || (tte.bound == Bound::Upper && tt_value <= alpha))
+                return tt_value;
+        }
+
+        int stand_pat = Eval::evaluate(game);
+
+        // The evaluation detects wins on this turn and games already lost
+        if (stand_pat >= value_win_in_max_ply)
+            return stand_pat - ss->depth;
+        if (stand_pat <= -value_win_in_max_ply)
+            return stand_pat + ss->depth;
+
+        // Is there an opponent pawn about to promote?
+        bool threatened = false;
+        for (int x = 0; x < width; ++x)
+            threatened |= std::as_const(game).cell_at(x, relative_row(us, 1)) == cell_of(!us);
+
+        int best_score;
+        if (threatened) {
+            // Not capturing the pawn loses on the next move
+            best_score = -value_win + ss->depth + 1;
+        }
+        else {
+            best_score = stand_pat;
+
+            if (stand_pat >= beta || qdepth == 0)
+                return stand_pat;
+        }
+
+        if (best_score > alpha)
+            alpha = best_score;
+
+        std::array<Move, max_n_moves> moves;
+        int n_moves = 0;
+
+        game.compute_valid_moves();
+        for (auto [it, end] = game.valid_moves(); it != end; ++it) {
+            const bool capture = game.is_capture(*it);
+            const bool threat = relative_row(us, it->to.row) >= threat_row;
+
+            if (threatened ? !capture : !(capture || threat))
+                continue;
+
+            // Delta pruning: a simple capture can't bring the score up to alpha
+            if (!threatened && !threat
+                && stand_pat + pawn_value + delta_margin <= alpha)
+                continue;
+
+            moves[n_moves++] = *it;
+        }
+
+        // Most advanced pawns first
+        std::stable_sort(moves.begin(), moves.begin() + n_moves,
+                         [us](const auto& a, const auto& b) {
+                             return relative_row(us, a.to.row) > relative_row(us, b.to.row);
+                         });
+
+        if (tt_hit)
+            put_first(moves.begin(), moves.begin() + n_moves, tte.move);
+
+        Move best_move = Move_None;
+        StateInfo st{};
+        (ss + 1)->depth = ss->depth + 1;
+
+        for (auto it = moves.begin(); it != moves.begin() + n_moves; ++it) {
+
+            game.apply(*it, st);
+            int score = -qsearch(-beta, -alpha, std::max(qdepth - 1, 0), ss + 1);
+            game.undo(*it);
+
+            if (stopped())
+                return 0;
+
+            if (score > best_score) {
+                best_score = score;
+
+                if (score > alpha) {
+                    best_move = *it;
+
+                    if (score < beta)
+                        alpha = score;
+                    else
+                        break;
+                }
+            }
+        }
+
+        // Only results of a complete quiescence search are worth keeping
+        if (qdepth == qs_max_depth) {
+            Bound bound = best_score >= beta ? Bound::Lower
+                : best_move != Move_None ? Bound::Exact
+                : Bound::Upper;
+
+            TT.store(key, value_to_tt(best_score, ss->depth), bound, 0, best_move);
+        }
+
         return best_score;
     }
@@ -1,5 +1,9 @@
 #include "types.h"
 #include "breakthrough.h"
+#include "solver.h"
+
+#include <atomic>
+#include <vector>
 
 class Agent {
 
@@ -50,6 +54,28 @@ public:
     /** Same as simple_best_move but run minimax at depth `search_depth' to pick the best move */
     Move best_move(int search_depth, int search_width = max_n_moves);
 
+    /**
+     * Iterative deepening from `start_depth' up to `search_depth', returning
+     * the best move of the last completed iteration.
+     *
+     * NOTE: Unlike best_move(), this doesn't start a new search in the
+     * transposition table so that Lazy SMP threads can share it.
+     */
+    Move iterative_deepening(int start_depth, int search_depth, int search_width = max_n_moves);
+
+    /**
+     * Make the agent a helper thread: it doesn't output anything
+     * and aborts its search as soon as `stop' is set.
+     */
+    void set_helper(const std::atomic<bool>* stop);
+
+    /** Depth of the last completed iteration, -1 if none */
+    int completed_depth() const { return m_completed_depth; }
+    int best_score() const { return m_best_score; }
+    long long nodes() const { return n_evals; }
+    long long tt_probes() const { return n_tt_probes; }
+    long long tt_hits() const { return n_tt_hits; }
+
     /** Generate root moves and order them wrt to the score_move() method */
     void make_root();
 
@@ -61,11 +87,25 @@ private:
     std::vector<ExtMove> root_moves;
     std::vector<Move> move_buf;
     StateInfo states[max_depth];
-    int n_evals = 0;
+    Solver solver;
+    long long n_evals = 0;
+    long long n_tt_probes = 0;
+    long long n_tt_hits = 0;
+    int m_completed_depth = -1;
+    int m_best_score = -32001;
+    const std::atomic<bool>* stop = nullptr;
+
+    bool stopped() const;
 
     /** Witout alpha beta pruning */
     int simple_eval_minimax(int depth, Stack* ss);
 
     /** With alpha beta pruning */
     int eval_minimax(int alpha, int beta, int depth, int width, Stack* ss);
+
+    /**
+     * Search only captures and promotion threats until the position is quiet,
+     * at most `qdepth' plies deep.
+     */
+    int qsearch(int alpha, int beta, int qdepth, Stack* ss);
 };
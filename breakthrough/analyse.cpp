@@ -0,0 +1,62 @@
+#include "types.h"
+#include "breakthrough.h"
+#include "smp.h"
+#include "tt.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * Offline analysis using all cores
+ *
+ * Usage: analyse [depth] [threads] [board_file [W|B]]
+ *
+ * The board file holds 8 lines of 8 characters ('.', 'W' or 'B') from
+ * rank 8 down to rank 1, as in data/passed_pawns.txt. Without one, the
+ * start position is analysed.
+ */
+int main(int argc, char* argv[])
+{
+    int s_depth = argc > 1 ? std::stoi(argv[1]) : 6;
+    int n_threads = argc > 2 ? std::stoi(argv[2]) : SMP::default_threads();
+
+    Game game;
+
+    if (argc > 3) {
+        std::ifstream ifs { argv[3] };
+        if (!ifs) {
+            std::cerr << "failed to open input file "
+                << argv[3] << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::string board, line;
+        while (board.size() < Nsquares && std::getline(ifs, line))
+            board += line;
+        Player to_move = argc > 4 && argv[4][0] == 'B' ? Player::Black : Player::White;
+        game.set_board(board, to_move);
+    }
+
+    TT.resize(256);
+
+    std::cout << game.view();
+
+    for (int depth = 0; depth <= s_depth; ++depth) {
+        auto start = std::chrono::steady_clock::now();
+        SMP::Result res = SMP::search(game, depth, n_threads);
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "depth " << depth
+                  << " (" << res.depth << ")"
+                  << " move " << Game::view_move(res.move)
+                  << " score " << res.score
+                  << " nodes " << res.nodes
+                  << " nps " << static_cast<long long>(res.nodes / std::max(secs, 1e-9))
+                  << " time " << secs << "s"
+                  << " hashfull " << TT.hashfull()
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
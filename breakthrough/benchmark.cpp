@@ -0,0 +1,236 @@
+#include "types.h"
+#include "agent.h"
+#include "breakthrough.h"
+#include "eval.h"
+#include "tt.h"
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Reproducible performance measurements of the engine
+ *
+ * Usage: breakthrough_bench [perft_depth] [search_depth] [positions_file]
+ *
+ * 1. perft from the start position up to `perft_depth' (default 6)
+ * 2. evaluations per second over random positions
+ * 3. fixed depth searches up to `search_depth' (default 5) over the positions
+ *    of `positions_file' (default data/bench.txt), each one starting from an
+ *    empty transposition table, reporting time-to-depth, nodes/s, transposition
+ *    table hit rate and effective branching factor.
+ *
+ * The positions file holds boards of 8 lines of 8 characters ('.', 'W' or 'B')
+ * from rank 8 down to rank 1, each one optionally followed by a line with the
+ * side to move ('W' or 'B', White by default). Blank lines are ignored.
+ */
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int n_positions = 2000;
+    constexpr int n_rounds = 500;
+
+    double seconds_since(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    /** Number of leaves at depth `depth', with bulk counting at the last ply */
+    long long perft(Game& game, int depth, StateInfo* st) {
+        if (game.is_won())
+            return 0;
+
+        game.compute_valid_moves();
+        auto [beg, end] = game.valid_moves();
+
+        if (depth == 1)
+            return std::distance(beg, end);
+
+        std::array<Move, max_n_moves> moves;
+        const int n_moves = std::distance(beg, end);
+        std::copy(beg, end, moves.begin());
+
+        long long ret = 0;
+        for (int i = 0; i < n_moves; ++i) {
+            game.apply(moves[i], *st);
+            ret += perft(game, depth - 1, st + 1);
+            game.undo(moves[i]);
+        }
+        return ret;
+    }
+
+    void bench_perft(int max_depth_perft) {
+        std::cout << "perft\n";
+
+        Game game;
+        StateInfo states[max_depth];
+
+        for (int depth = 1; depth <= max_depth_perft; ++depth) {
+            auto start = Clock::now();
+            long long nodes = perft(game, depth, &states[0]);
+            double secs = seconds_since(start);
+
+            std::cout << "  depth " << depth
+                      << "  nodes " << std::setw(12) << nodes
+                      << "  time " << std::fixed << std::setprecision(3) << secs << "s"
+                      << "  nps " << static_cast<long long>(nodes / std::max(secs, 1e-9))
+                      << std::defaultfloat << '\n';
+        }
+    }
+
+    /**
+     * Play a random game to completion, then take back a random
+     * number of moves so that the game ends up in a random position.
+     */
+    void random_position(Game& game, StateInfo* states, std::mt19937& rng) {
+        std::vector<Move> moves;
+
+        while (!game.is_won()) {
+            game.compute_valid_moves();
+            auto [beg, end] = game.valid_moves();
+            std::uniform_int_distribution<int> dist(0, std::distance(beg, end) - 1);
+            moves.push_back(*(beg + dist(rng)));
+            game.apply(moves.back(), states[moves.size() - 1]);
+        }
+
+        std::uniform_int_distribution<size_t> dist(1, moves.size());
+        for (size_t n = dist(rng); n > 0; --n) {
+            game.undo(moves.back());
+            moves.pop_back();
+        }
+    }
+
+    void bench_eval() {
+        std::mt19937 rng { 42 };
+
+        std::vector<Game> games(n_positions);
+        std::vector<std::array<StateInfo, max_depth>> states(n_positions);
+
+        for (int i = 0; i < n_positions; ++i)
+            random_position(games[i], states[i].data(), rng);
+
+        long long checksum = 0;
+        auto start = Clock::now();
+
+        for (int round = 0; round < n_rounds; ++round)
+            for (const auto& game : games)
+                checksum += Eval::evaluate(game);
+
+        double secs = seconds_since(start);
+        double n_evals = static_cast<double>(n_rounds) * n_positions;
+
+        std::cout << "\neval\n"
+                  << "  " << n_positions << " positions "
+                  << n_rounds << " times in " << secs << "s"
+                  << "  evals/second " << static_cast<long long>(n_evals / secs)
+                  << "  checksum " << checksum << '\n';
+    }
+
+    std::vector<std::pair<std::string, Player>> read_positions(std::istream& is) {
+        std::vector<std::pair<std::string, Player>> ret;
+        std::string board, line;
+
+        while (std::getline(is, line)) {
+            if (line.empty())
+                continue;
+            if (board.size() == Nsquares && line.size() == 1) {
+                ret.emplace_back(board, line[0] == 'B' ? Player::Black : Player::White);
+                board.clear();
+                continue;
+            }
+            if (board.size() == Nsquares) {
+                ret.emplace_back(board, Player::White);
+                board.clear();
+            }
+            board += line;
+        }
+        if (board.size() == Nsquares)
+            ret.emplace_back(board, Player::White);
+
+        return ret;
+    }
+
+    void bench_search(const std::vector<std::pair<std::string, Player>>& positions, int s_depth) {
+        long long total_nodes = 0;
+        double total_time = 0;
+
+        for (size_t i = 0; i < positions.size(); ++i) {
+            Game game;
+            game.set_board(positions[i].first, positions[i].second);
+            game.compute_valid_moves();
+
+            const std::atomic<bool> never_stop { false };
+            Agent agent { game };
+            agent.set_helper(&never_stop);
+
+            TT.clear();
+            TT.new_search();
+
+            std::cout << "\nsearch position " << i + 1 << game.view();
+
+            long long nodes = 0, prev_nodes = 0;
+            long long probes = 0, hits = 0;
+            auto start = Clock::now();
+
+            // Same as one iterative deepening, but measuring each iteration
+            for (int depth = 0; depth <= s_depth; ++depth) {
+                Move move = agent.iterative_deepening(depth, depth);
+                double secs = seconds_since(start);
+
+                nodes += agent.nodes();
+                probes += agent.tt_probes();
+                hits += agent.tt_hits();
+
+                std::cout << "  depth " << std::setw(2) << depth
+                          << "  move " << Game::view_move(move)
+                          << "  score " << std::setw(6) << agent.best_score()
+                          << "  nodes " << std::setw(10) << nodes
+                          << "  time " << std::fixed << std::setprecision(3) << secs << "s"
+                          << "  nps " << std::setw(9) << static_cast<long long>(nodes / std::max(secs, 1e-9))
+                          << "  tt hits " << std::setprecision(1) << 100.0 * hits / std::max(probes, 1LL) << "%"
+                          << "  ebf " << std::setprecision(2)
+                          << (prev_nodes ? static_cast<double>(agent.nodes()) / prev_nodes : 0.0)
+                          << std::defaultfloat << '\n';
+
+                prev_nodes = agent.nodes();
+
+                if (agent.best_score() >= value_win_in_max_ply)
+                    break;
+            }
+
+            total_nodes += nodes;
+            total_time += seconds_since(start);
+        }
+
+        std::cout << "\nsearch total: " << total_nodes << " nodes in "
+                  << total_time << "s, nps "
+                  << static_cast<long long>(total_nodes / std::max(total_time, 1e-9)) << '\n';
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    int perft_depth = argc > 1 ? std::stoi(argv[1]) : 6;
+    int s_depth = argc > 2 ? std::stoi(argv[2]) : 5;
+    std::string fn = argc > 3 ? argv[3] : "data/bench.txt";
+
+    std::ifstream ifs { fn };
+    if (!ifs) {
+        std::cerr << "failed to open input file "
+            << fn << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto positions = read_positions(ifs);
+
+    bench_perft(perft_depth);
+    bench_eval();
+    bench_search(positions, s_depth);
+
+    return EXIT_SUCCESS;
+}
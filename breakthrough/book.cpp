@@ -0,0 +1,32 @@
+#include "book.h"
+#include "book_data.h"
+#include "breakthrough.h"
+
+#include <algorithm>
+
+namespace {
+
+    constexpr bool key_less(const Book::Entry& entry, Key key) {
+        return entry.key < key;
+    }
+
+    static_assert(std::is_sorted(Book::entries.begin(), Book::entries.end(),
+                                 [](const auto& a, const auto& b) { return a.key < b.key; }),
+                  "book entries have to be sorted by key");
+
+}  // namespace
+
+Move Book::probe(const Game& game) {
+    const Key key = game.key();
+    auto it = std::lower_bound(entries.begin(), entries.end(), key, key_less);
+
+    if (it == entries.end() || it->key != key)
+        return Move_None;
+
+    // Guard against key collisions
+    const Move move = unpack_move(it->move);
+    game.compute_valid_moves();
+    auto [beg, end] = game.valid_moves();
+
+    return std::find(beg, end, move) != end ? move : Move_None;
+}
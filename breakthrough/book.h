@@ -0,0 +1,27 @@
+#ifndef __BOOK_H_
+#define __BOOK_H_
+
+#include "types.h"
+
+#include <cstdint>
+
+class Game;
+
+namespace Book {
+
+/**
+ * A book position and the move to play there.
+ *
+ * NOTE: The move is packed with pack_move()
+ */
+struct Entry {
+    Key key;
+    uint16_t move;
+};
+
+/** Book move for the position, Move_None if it isn't in the book */
+Move probe(const Game&);
+
+} // namespace Book
+
+#endif
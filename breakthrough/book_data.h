@@ -0,0 +1,447 @@
+#ifndef __BOOK_DATA_H_
+#define __BOOK_DATA_H_
+
+// Generated by book_gen: depth 6, 4 plies
+
+#include "book.h"
+
+#include <array>
+
+namespace Book {
+
+constexpr std::array<Entry, 430> entries {{
+    { 0x0032e040efa60346ULL, 0x0c78 }, // a8b7
+    { 0x00582c36e4d05d73ULL, 0x0af2 }, // c7d6
+    { 0x0084690eff252a7aULL, 0x0c78 }, // a8b7
+    { 0x00dc840505a817c4ULL, 0x0c78 }, // a8b7
+    { 0x00ed2881a0a906c4ULL, 0x0dbf }, // h8g7
+    { 0x014a64b993b88568ULL, 0x0bb6 }, // g7g6
+    { 0x0157b5663c35afb7ULL, 0x0dbf }, // h8g7
+    { 0x024d56c468a34376ULL, 0x0dbf }, // h8g7
+    { 0x03cfa7b23e3a6d03ULL, 0x0af2 }, // c7d6
+    { 0x059efe1855c5656fULL, 0x0dbf }, // h8g7
+    { 0x0734e65f1e1ac3d6ULL, 0x0ab1 }, // b7c6
+    { 0x074e543d806a0aa3ULL, 0x0dbf }, // h8g7
+    { 0x07ab4496172d4eb9ULL, 0x0b76 }, // g7f6
+    { 0x07d1f6f4895d87ccULL, 0x0dbf }, // h8g7
+    { 0x0972a26fecaa1430ULL, 0x0b35 }, // f7e6
+    { 0x0987f387775d9bedULL, 0x0dbf }, // h8g7
+    { 0x09b65f03d25c8aedULL, 0x0c78 }, // a8b7
+    { 0x0ac4b4c12cdc1dd5ULL, 0x0af2 }, // c7d6
+    { 0x0adc68c19b6f4c52ULL, 0x0af2 }, // c7d6
+    { 0x0b76a6973abf715aULL, 0x0c78 }, // a8b7
+    { 0x0c63552e1a9e50bcULL, 0x0b35 }, // f7e6
+    { 0x0cbc9def5591553eULL, 0x0c78 }, // a8b7
+    { 0x0d2b7d5415b3e39bULL, 0x0af2 }, // c7d6
+    { 0x0ddff476c82a6e9fULL, 0x0af2 }, // c7d6
+    { 0x0e1523bff29f868aULL, 0x0c78 }, // a8b7
+    { 0x0e8a8176fba80be5ULL, 0x0af2 }, // c7d6
+    { 0x0f28dea97d6f5ffbULL, 0x0af2 }, // c7d6
+    { 0x0f9e12dccb023ef9ULL, 0x0b35 }, // f7e6
+    { 0x10ed42e90cec4bd8ULL, 0x0dbf }, // h8g7
+    { 0x1151e3b1de5875fbULL, 0x0af2 }, // c7d6
+    { 0x118e2b7091577079ULL, 0x0dbf }, // h8g7
+    { 0x11bf87f434566179ULL, 0x0af2 }, // c7d6
+    { 0x11f73f05e3f6cc01ULL, 0x0b35 }, // f7e6
+    { 0x12aca4430fc41bbeULL, 0x0af2 }, // c7d6
+    { 0x132795203659a3cdULL, 0x0dbf }, // h8g7
+    { 0x145b215d5995aa28ULL, 0x0c78 }, // a8b7
+    { 0x14fbce4e55dae1f1ULL, 0x0b76 }, // g7f6
+    { 0x162d57ccb1947c1eULL, 0x0b35 }, // f7e6
+    { 0x16b2f505b8a3f171ULL, 0x0dbf }, // h8g7
+    { 0x1758122be9c40817ULL, 0x0c78 }, // a8b7
+    { 0x17eede5e5fa96915ULL, 0x0dbf }, // h8g7
+    { 0x17f6025ee81a3892ULL, 0x0dbf }, // h8g7
+    { 0x180a43d9d62a6cefULL, 0x0240 }, // a1b2
+    { 0x1811a19edd54628dULL, 0x0b35 }, // f7e6
+    { 0x1880fe7e9ab390eaULL, 0x0240 }, // a1b2
+    { 0x18a60efa50b20c96ULL, 0x0dbf }, // h8g7
+    { 0x18ac488791034028ULL, 0x0c78 }, // a8b7
+    { 0x18e4cf1a45f7710cULL, 0x0c78 }, // a8b7
+    { 0x1bc67f45d8308697ULL, 0x0af2 }, // c7d6
+    { 0x1c6503f9f8f38af0ULL, 0x0c78 }, // a8b7
+    { 0x1cfaa130f1c4079fULL, 0x0af2 }, // c7d6
+    { 0x1d0056df2b602601ULL, 0x0b35 }, // f7e6
+    { 0x1d0c353362aaab90ULL, 0x0b76 }, // g7f6
+    { 0x1ddf9e1e646f2383ULL, 0x0c78 }, // a8b7
+    { 0x1dee329ac16e3283ULL, 0x0b35 }, // f7e6
+    { 0x1ead75dc9aefb4bbULL, 0x0c78 }, // a8b7
+    { 0x1efe3b16342edd21ULL, 0x0c78 }, // a8b7
+    { 0x20e93ff5bccad612ULL, 0x0b76 }, // g7f6
+    { 0x2113b8f7d54314deULL, 0x0c78 }, // a8b7
+    { 0x2131cc700995e793ULL, 0x0b35 }, // f7e6
+    { 0x21fddcb23f4d005cULL, 0x0a70 }, // a7b6
+    { 0x22edea1736b2e450ULL, 0x0240 }, // a1b2
+    { 0x238baa23d74cd66aULL, 0x0dbf }, // h8g7
+    { 0x2468c5f4edeef52fULL, 0x0c78 }, // a8b7
+    { 0x2473b66d59f89538ULL, 0x0af2 }, // c7d6
+    { 0x2505559ded79943cULL, 0x0ab1 }, // b7c6
+    { 0x27d2e8ba0c5526f9ULL, 0x0b76 }, // g7f6
+    { 0x280077847016358fULL, 0x0c78 }, // a8b7
+    { 0x28ae22cad7264d34ULL, 0x0af2 }, // c7d6
+    { 0x2a25b31ea7f88919ULL, 0x0af2 }, // c7d6
+    { 0x2aba11d7aecf0476ULL, 0x0c78 }, // a8b7
+    { 0x2b37fb91d0905102ULL, 0x0bb6 }, // g7g6
+    { 0x2ba85958d9a7dc6dULL, 0x0bb7 }, // h7g6
+    { 0x2c068a2fc3ef6d95ULL, 0x0ab1 }, // b7c6
+    { 0x2c0b25e4f964d00aULL, 0x0bb6 }, // g7g6
+    { 0x2d196d6b8e0c0811ULL, 0x0c78 }, // a8b7
+    { 0x2d420d99207b4724ULL, 0x0dbf }, // h8g7
+    { 0x2d86cfa2873b857eULL, 0x0c78 }, // a8b7
+    { 0x2dac69dcca7553a6ULL, 0x0b35 }, // f7e6
+    { 0x2e278f4d7f7e9a55ULL, 0x0b76 }, // g7f6
+    { 0x2e520415d53ba886ULL, 0x0c78 }, // a8b7
+    { 0x2fdde21f0d1e4673ULL, 0x0240 }, // a1b2
+    { 0x3070bb06e4bd6263ULL, 0x0af2 }, // c7d6
+    { 0x309edf430eb376e1ULL, 0x0af2 }, // c7d6
+    { 0x30b4793d43fda039ULL, 0x0dbf }, // h8g7
+    { 0x30f4133505c528d4ULL, 0x0c78 }, // a8b7
+    { 0x31e65bba72adf0cfULL, 0x0bb7 }, // h7g6
+    { 0x3440039f097fda58ULL, 0x0bb6 }, // g7g6
+    { 0x3480fee80af97f7cULL, 0x0ab1 }, // b7c6
+    { 0x3510b59c6806e385ULL, 0x0af2 }, // c7d6
+    { 0x3532c11bb4d010c8ULL, 0x0dbf }, // h8g7
+    { 0x36a1fb8ab66888bcULL, 0x0b76 }, // g7f6
+    { 0x36c0f68b25f9983bULL, 0x0c78 }, // a8b7
+    { 0x3788a7486a092131ULL, 0x0b35 }, // f7e6
+    { 0x38fcee5e3a0ae1f4ULL, 0x0bb6 }, // g7g6
+    { 0x391a60003349ff4aULL, 0x0c78 }, // a8b7
+    { 0x394100f29d3eb07fULL, 0x0dbf }, // h8g7
+    { 0x3a4e4e50c94d333bULL, 0x0b76 }, // g7f6
+    { 0x3acab7c63d466fd0ULL, 0x0c78 }, // a8b7
+    { 0x3c037aefcd53c2d4ULL, 0x0c78 }, // a8b7
+    { 0x3cc08273f6dadebcULL, 0x0b76 }, // g7f6
+    { 0x3ccf6a2dfb8b251bULL, 0x0b35 }, // f7e6
+    { 0x3d113260ba3b1acfULL, 0x0bb6 }, // g7g6
+    { 0x3d75991f79d2c3d0ULL, 0x0ab1 }, // b7c6
+    { 0x3e26be751abd7e42ULL, 0x0c78 }, // a8b7
+    { 0x3e66ad1e00dc5160ULL, 0x0b35 }, // f7e6
+    { 0x3eb91cbc138af32dULL, 0x0c78 }, // a8b7
+    { 0x3f650a566434a49cULL, 0x0240 }, // a1b2
+    { 0x3fa2243898fe7115ULL, 0x0b76 }, // g7f6
+    { 0x419401f2d74e52b3ULL, 0x0b35 }, // f7e6
+    { 0x41abd8b87bde4454ULL, 0x0240 }, // a1b2
+    { 0x41dcb90300eeffcbULL, 0x0c78 }, // a8b7
+    { 0x42df8a75b0bf5df4ULL, 0x0af2 }, // c7d6
+    { 0x42f94fe7b43b06bdULL, 0x0b76 }, // g7f6
+    { 0x44786b9a86fd109dULL, 0x0b35 }, // f7e6
+    { 0x44c66b2e0ce0f8e0ULL, 0x0af2 }, // c7d6
+    { 0x44d67bef87232018ULL, 0x0c78 }, // a8b7
+    { 0x4562167669e79744ULL, 0x0dbf }, // h8g7
+    { 0x45a33e08df735411ULL, 0x0dbf }, // h8g7
+    { 0x473b2cdcdd7c96a5ULL, 0x0a70 }, // a7b6
+    { 0x4887ce81721b73e2ULL, 0x0b35 }, // f7e6
+    { 0x4897de40f9d8ab1aULL, 0x0b35 }, // f7e6
+    { 0x48e12e86883c1af0ULL, 0x0c78 }, // a8b7
+    { 0x499f9c32b0cd90d0ULL, 0x0dbf }, // h8g7
+    { 0x4b31f94086338a6aULL, 0x0c78 }, // a8b7
+    { 0x4b6a99b22844c55fULL, 0x0dbf }, // h8g7
+    { 0x4b71ea2b9c52a548ULL, 0x0b35 }, // f7e6
+    { 0x4bae5b898f040705ULL, 0x0af2 }, // c7d6
+    { 0x4bdc55c79e29a45dULL, 0x0c78 }, // a8b7
+    { 0x4c19f336972a4f3eULL, 0x0c78 }, // a8b7
+    { 0x4d30e574b9818e94ULL, 0x0af2 }, // c7d6
+    { 0x4dc58bf021229d15ULL, 0x0b35 }, // f7e6
+    { 0x4dc5b49c22760149ULL, 0x0af2 }, // c7d6
+    { 0x4e28e3af7829b7f4ULL, 0x0c78 }, // a8b7
+    { 0x4e303fafcf9ae673ULL, 0x0c78 }, // a8b7
+    { 0x50afaa33bad3518eULL, 0x0af2 }, // c7d6
+    { 0x50f70203e6b0240eULL, 0x0b35 }, // f7e6
+    { 0x512b45a953ec6a79ULL, 0x0b35 }, // f7e6
+    { 0x530289300b5cc334ULL, 0x0dbf }, // h8g7
+    { 0x531a5530bcef92b3ULL, 0x0dbf }, // h8g7
+    { 0x53ac99450a82f3b1ULL, 0x0c78 }, // a8b7
+    { 0x543288647d3c38f8ULL, 0x0c78 }, // a8b7
+    { 0x55a568df3d1e8e5dULL, 0x0c78 }, // a8b7
+    { 0x55b5781eb6dd56a5ULL, 0x0c78 }, // a8b7
+    { 0x56435cb45894800fULL, 0x0af2 }, // c7d6
+    { 0x56582f2dec82e018ULL, 0x0af2 }, // c7d6
+    { 0x569ced164bc22242ULL, 0x0dbf }, // h8g7
+    { 0x580e2a5e1282fc39ULL, 0x0c78 }, // a8b7
+    { 0x585e3e42c1bce394ULL, 0x0ab1 }, // b7c6
+    { 0x5860b041ff05d3beULL, 0x0240 }, // a1b2
+    { 0x589188971bb57156ULL, 0x0af2 }, // c7d6
+    { 0x59ac75819445a827ULL, 0x0af2 }, // c7d6
+    { 0x59c540b86a961ce7ULL, 0x0c78 }, // a8b7
+    { 0x59e4cd7043e5055fULL, 0x0b35 }, // f7e6
+    { 0x59f4ddb1c826dda7ULL, 0x0b35 }, // f7e6
+    { 0x5a59feb279a94f1dULL, 0x0c78 }, // a8b7
+    { 0x5a85bb8a625c3814ULL, 0x0af2 }, // c7d6
+    { 0x5ca6880110dceba8ULL, 0x0b35 }, // f7e6
+    { 0x5ca6b76d138877f4ULL, 0x0af2 }, // c7d6
+    { 0x5d12daf4fd4cc0a8ULL, 0x0b35 }, // f7e6
+    { 0x5e20bca44c1ea52aULL, 0x0bb6 }, // g7g6
+    { 0x5ebf1e6d45292845ULL, 0x0bb6 }, // g7g6
+    { 0x609c4e9a0ea80e89ULL, 0x0c78 }, // a8b7
+    { 0x633a10f92d1a8836ULL, 0x0b35 }, // f7e6
+    { 0x63a5b230242d0559ULL, 0x0dbf }, // h8g7
+    { 0x63e3278a8c494dd5ULL, 0x0240 }, // a1b2
+    { 0x6405689be83f7c33ULL, 0x0b76 }, // g7f6
+    { 0x6461c3e42bd6a52cULL, 0x0bb7 }, // h7g6
+    { 0x65738b6b5cbe7d37ULL, 0x0af2 }, // c7d6
+    { 0x65dd9b1e5d604db2ULL, 0x0dbf }, // h8g7
+    { 0x6630d215aad757e5ULL, 0x0b35 }, // f7e6
+    { 0x667150ad3630c260ULL, 0x0489 }, // b2c3
+    { 0x66d2d5bc0913cef6ULL, 0x0b76 }, // g7f6
+    { 0x68f2014120a99633ULL, 0x0ab1 }, // b7c6
+    { 0x69004a827550dd80ULL, 0x0c78 }, // a8b7
+    { 0x69697fbb8b836940ULL, 0x0c78 }, // a8b7
+    { 0x697244cc647d7ed8ULL, 0x0c78 }, // a8b7
+    { 0x69ede6056d4af3b7ULL, 0x0af2 }, // c7d6
+    { 0x6c5aa9a43460b692ULL, 0x0c78 }, // a8b7
+    { 0x6c86ec9c2f95c19bULL, 0x0c78 }, // a8b7
+    { 0x6d16a7e84d6a5d62ULL, 0x0b74 }, // e7f6
+    { 0x6d94a41358fd1980ULL, 0x0bb6 }, // g7g6
+    { 0x6ff4075ed11556a3ULL, 0x0af2 }, // c7d6
+    { 0x71708600e1fb8a6cULL, 0x0c78 }, // a8b7
+    { 0x7223a16a829437feULL, 0x0b33 }, // d7e6
+    { 0x725570e4552e731aULL, 0x0b76 }, // g7f6
+    { 0x725913081ce4fe8bULL, 0x0dbf }, // h8g7
+    { 0x7273b57651aa2853ULL, 0x0c78 }, // a8b7
+    { 0x72bc03a38ba3ba91ULL, 0x0b76 }, // g7f6
+    { 0x72c6b1c115d373e4ULL, 0x0b35 }, // f7e6
+    { 0x7400985be683d372ULL, 0x0c78 }, // a8b7
+    { 0x7440f253a0bb5b9fULL, 0x0dbf }, // h8g7
+    { 0x7512d0d491eb0b69ULL, 0x0bb6 }, // g7g6
+    { 0x751f7f1fab60b6f6ULL, 0x0ab1 }, // b7c6
+    { 0x774bf125bdb473e5ULL, 0x0c78 }, // a8b7
+    { 0x77b1d64d38edb84bULL, 0x0b76 }, // g7f6
+    { 0x7885e1f792d036c0ULL, 0x0c78 }, // a8b7
+    { 0x78ef2d8199a668f5ULL, 0x0c78 }, // a8b7
+    { 0x7b02648a6e1172a2ULL, 0x0c78 }, // a8b7
+    { 0x7b9dc6436726ffcdULL, 0x0c78 }, // a8b7
+    { 0x7c75a4197c942bdfULL, 0x0b76 }, // g7f6
+    { 0x7d0347e9c8152adbULL, 0x0c78 }, // a8b7
+    { 0x7e3e3ca8de009476ULL, 0x0c78 }, // a8b7
+    { 0x7e9704afe0eb201eULL, 0x0af2 }, // c7d6
+    { 0x7ea2193e9db8991aULL, 0x0b76 }, // g7f6
+    { 0x80cfff73ab095122ULL, 0x0b35 }, // f7e6
+    { 0x82c84f6ea0311ef9ULL, 0x0c78 }, // a8b7
+    { 0x83181eff37dbe9bfULL, 0x0af2 }, // c7d6
+    { 0x831fbc64e6f62a9cULL, 0x0b35 }, // f7e6
+    { 0x833edb6d335fb2f6ULL, 0x0b76 }, // g7f6
+    { 0x83623bea136cb9cfULL, 0x0d3c }, // e8e7
+    { 0x84797b5df79aca85ULL, 0x0af3 }, // d7d6
+    { 0x85273a368f0017e2ULL, 0x0b76 }, // g7f6
+    { 0x852b59dac6ca9a73ULL, 0x0b35 }, // f7e6
+    { 0x85f4911b89c59ff1ULL, 0x0c78 }, // a8b7
+    { 0x894392c9076bfd1cULL, 0x0dbf }, // h8g7
+    { 0x89dc30000e5c7073ULL, 0x0dbf }, // h8g7
+    { 0x8a1bc14d194d1016ULL, 0x0af2 }, // c7d6
+    { 0x8be98a8e4cb45ba5ULL, 0x0ab1 }, // b7c6
+    { 0x8c01e8d457068fb7ULL, 0x0a70 }, // a7b6
+    { 0x8c036a66beb5d590ULL, 0x0c78 }, // a8b7
+    { 0x8db325ed2a4c760fULL, 0x0240 }, // a1b2
+    { 0x8ee34862cb798476ULL, 0x0b76 }, // g7f6
+    { 0x8ff7ab2548fe5238ULL, 0x0c78 }, // a8b7
+    { 0x903bc5ac78ca36c3ULL, 0x0240 }, // a1b2
+    { 0x91335e4b93c0aaf0ULL, 0x0dbf }, // h8g7
+    { 0x914efb2b3933be8cULL, 0x0b76 }, // g7f6
+    { 0x91683eb93db7e5c5ULL, 0x0af2 }, // c7d6
+    { 0x91acfc829af7279fULL, 0x0dbf }, // h8g7
+    { 0x926b0dcf8de647faULL, 0x0c78 }, // a8b7
+    { 0x92c51dba8c38777fULL, 0x0dbf }, // h8g7
+    { 0x93b56aeecf02e472ULL, 0x0bb6 }, // g7g6
+    { 0x944439c7befe615fULL, 0x0b76 }, // g7f6
+    { 0x94712456c3add85bULL, 0x0a70 }, // a7b6
+    { 0x960d028c538771dfULL, 0x0dbf }, // h8g7
+    { 0x9802d432edf2a8acULL, 0x0c78 }, // a8b7
+    { 0x9819ef45020cbf34ULL, 0x0c78 }, // a8b7
+    { 0x98864d8c0b3b325bULL, 0x0c78 }, // a8b7
+    { 0x98c627844d03bab6ULL, 0x0b35 }, // f7e6
+    { 0x9999aac846d857dfULL, 0x0ab1 }, // b7c6
+    { 0x9cfb9b08bf9ef81dULL, 0x0240 }, // a1b2
+    { 0x9d62eb2566f8f90aULL, 0x0af2 }, // c7d6
+    { 0x9e8f9d7908f9bfdaULL, 0x0c78 }, // a8b7
+    { 0x9eb2a8322b0782b4ULL, 0x0c78 }, // a8b7
+    { 0x9f804b93fa87f2cbULL, 0x0b76 }, // g7f6
+    { 0x9fae47fa1a22f70fULL, 0x0c78 }, // a8b7
+    { 0x9ffaf9f164f73bbeULL, 0x0b35 }, // f7e6
+    { 0xa0665e655a65c47cULL, 0x0af2 }, // c7d6
+    { 0xa0f9fcac53524913ULL, 0x0af2 }, // c7d6
+    { 0xa1c401badca29062ULL, 0x0af2 }, // c7d6
+    { 0xa1e2c428d826cb2bULL, 0x0b76 }, // g7f6
+    { 0xa23213eed6295bb1ULL, 0x0b76 }, // g7f6
+    { 0xa26922b96d2d02d8ULL, 0x0b35 }, // f7e6
+    { 0xa271feb9da9e535fULL, 0x0b35 }, // f7e6
+    { 0xa28746fc8723165aULL, 0x0dbf }, // h8g7
+    { 0xa2b6ea782222075aULL, 0x0af2 }, // c7d6
+    { 0xa2c732cc6cf3325dULL, 0x0c78 }, // a8b7
+    { 0xa304f82e34416bd5ULL, 0x0c78 }, // a8b7
+    { 0xa4cec3565b6f4fb1ULL, 0x0a70 }, // a7b6
+    { 0xa5bb86b1033f3bb8ULL, 0x0dbf }, // h8g7
+    { 0xa72394650130f90cULL, 0x0af2 }, // c7d6
+    { 0xa73384a48af321f4ULL, 0x0c78 }, // a8b7
+    { 0xa75a801073914574ULL, 0x0af2 }, // c7d6
+    { 0xa7c53ce1d74e64f1ULL, 0x0a70 }, // a7b6
+    { 0xa7cf7a9c16ff284fULL, 0x0dbf }, // h8g7
+    { 0xa82a728fea2e47fcULL, 0x0af2 }, // c7d6
+    { 0xa89f7638ae571c4bULL, 0x0dbf }, // h8g7
+    { 0xa8b5d046e319ca93ULL, 0x0c78 }, // a8b7
+    { 0xa8cc38f2009675d1ULL, 0x0dbf }, // h8g7
+    { 0xa96581d774f33dd5ULL, 0x0c78 }, // a8b7
+    { 0xa9fa231e7dc4b0baULL, 0x0c78 }, // a8b7
+    { 0xab32553b1fd88ef1ULL, 0x0c78 }, // a8b7
+    { 0xab72210bf408aaf6ULL, 0x0dbf }, // h8g7
+    { 0xac4ee14670148714ULL, 0x0dbf }, // h8g7
+    { 0xad89886453082c47ULL, 0x0c78 }, // a8b7
+    { 0xae23a27ae9ecca7dULL, 0x0af2 }, // c7d6
+    { 0xae9e4b63a5bbe8d8ULL, 0x0b35 }, // f7e6
+    { 0xaed6f392721b45a0ULL, 0x0af2 }, // c7d6
+    { 0xaf46b8e610e4d959ULL, 0x0ab1 }, // b7c6
+    { 0xaf84368f4aa16f01ULL, 0x0b35 }, // f7e6
+    { 0xb17c57d9b4d2a253ULL, 0x0c78 }, // a8b7
+    { 0xb1e3f510bde52f3cULL, 0x0c78 }, // a8b7
+    { 0xb2b680108e674a46ULL, 0x0af2 }, // c7d6
+    { 0xb3ad4baab0ff748aULL, 0x0c78 }, // a8b7
+    { 0xb431ea1f9e3f20e0ULL, 0x0240 }, // a1b2
+    { 0xb4c89581b90295fdULL, 0x0b35 }, // f7e6
+    { 0xb5274f639fc9a08cULL, 0x0240 }, // a1b2
+    { 0xb58766d927dfefd4ULL, 0x0b35 }, // f7e6
+    { 0xb5adc0a76a91390cULL, 0x0c78 }, // a8b7
+    { 0xb5e1c94365633c70ULL, 0x0b76 }, // g7f6
+    { 0xb640979430ce8fb1ULL, 0x0c78 }, // a8b7
+    { 0xb6508755bb0d5749ULL, 0x0c78 }, // a8b7
+    { 0xb6df2b659411ae34ULL, 0x0c78 }, // a8b7
+    { 0xb6ee87e13110bf34ULL, 0x0dbf }, // h8g7
+    { 0xb81692e7cece9390ULL, 0x0c78 }, // a8b7
+    { 0xb827205bc6272e7aULL, 0x0dbf }, // h8g7
+    { 0xb889302ec7f91effULL, 0x0c78 }, // a8b7
+    { 0xb8b88292cf10a315ULL, 0x0b35 }, // f7e6
+    { 0xb9fc75c99fa96af6ULL, 0x0dbf }, // h8g7
+    { 0xba01323b4e3504b3ULL, 0x0b35 }, // f7e6
+    { 0xbab7fe4ef85865b1ULL, 0x0c78 }, // a8b7
+    { 0xbaf78a7e138841b6ULL, 0x0b35 }, // f7e6
+    { 0xbb45b58dada12e02ULL, 0x0ab1 }, // b7c6
+    { 0xbc9061dc0681c14eULL, 0x0b76 }, // g7f6
+    { 0xbdcb4a3397946c54ULL, 0x0dbf }, // h8g7
+    { 0xbea9ec78f9b0c3fdULL, 0x0b35 }, // f7e6
+    { 0xbf2a4c92e73a1298ULL, 0x0af2 }, // c7d6
+    { 0xbf4348261e587618ULL, 0x0c78 }, // a8b7
+    { 0xbf5b9426a9eb279fULL, 0x0c78 }, // a8b7
+    { 0xbf845ce7e6e4221dULL, 0x0dbf }, // h8g7
+    { 0xbfb5f06343e5331dULL, 0x0c78 }, // a8b7
+    { 0xbfed1d68b9680ea3ULL, 0x0c78 }, // a8b7
+    { 0xc08df03314dc3123ULL, 0x0bb6 }, // g7g6
+    { 0xc09021ecbb511bfcULL, 0x0dbf }, // h8g7
+    { 0xc1dfd2b4258c61d5ULL, 0x0b35 }, // f7e6
+    { 0xc1eaa1ed95b9afadULL, 0x0240 }, // a1b2
+    { 0xc2083338b95ed948ULL, 0x0af2 }, // c7d6
+    { 0xc2a43caa4c6c986eULL, 0x0bb6 }, // g7g6
+    { 0xc2b397d8a2ce3eabULL, 0x0240 }, // a1b2
+    { 0xc2e6577d5350cdcaULL, 0x0c78 }, // a8b7
+    { 0xc46b10ec285c567bULL, 0x0c78 }, // a8b7
+    { 0xc4f4b225216bdb14ULL, 0x0c78 }, // a8b7
+    { 0xc661408033741beaULL, 0x0bb6 }, // g7g6
+    { 0xc78659e7dfeb4c2cULL, 0x0af2 }, // c7d6
+    { 0xc7ab5d02438859d7ULL, 0x0c78 }, // a8b7
+    { 0xc7ca5003d0194950ULL, 0x0b76 }, // g7f6
+    { 0xc8dc0d060b1a987cULL, 0x0dbf }, // h8g7
+    { 0xcb1bfc4b1c0bf819ULL, 0x0c78 }, // a8b7
+    { 0xcbd7ec892ad31fd6ULL, 0x0b35 }, // f7e6
+    { 0xcbf6f239bfa78d91ULL, 0x0b76 }, // g7f6
+    { 0xcd01d5d2524067b8ULL, 0x0af2 }, // c7d6
+    { 0xcd30676e5aa9da52ULL, 0x0dbf }, // h8g7
+    { 0xcd9e771b5b77ead7ULL, 0x0c78 }, // a8b7
+    { 0xcdafc5a7539e573dULL, 0x0dbf }, // h8g7
+    { 0xce5986564c668ab2ULL, 0x0b35 }, // f7e6
+    { 0xceb7e213a6689e30ULL, 0x0b35 }, // f7e6
+    { 0xd09d73389758727aULL, 0x0af2 }, // c7d6
+    { 0xd0acc1849fb1cf90ULL, 0x0dbf }, // h8g7
+    { 0xd2fdd0751eb03d59ULL, 0x0bb6 }, // g7g6
+    { 0xd36b30c988a0aff5ULL, 0x0c78 }, // a8b7
+    { 0xd385548c62aebb77ULL, 0x0a70 }, // a7b6
+    { 0xd3ef98fa69d8e542ULL, 0x0af2 }, // c7d6
+    { 0xd4ed2cc06f732041ULL, 0x0240 }, // a1b2
+    { 0xd5711950c6eb3054ULL, 0x0af2 }, // c7d6
+    { 0xd59cb5d7def11e63ULL, 0x0a70 }, // a7b6
+    { 0xd5eebb99cfdcbd3bULL, 0x0af2 }, // c7d6
+    { 0xd6294ad4d8cddd5eULL, 0x0b35 }, // f7e6
+    { 0xd6e55a16ee153a91ULL, 0x0c78 }, // a8b7
+    { 0xd7f71299997de28aULL, 0x0bb6 }, // g7g6
+    { 0xd959a673ec9a733cULL, 0x0dbf }, // h8g7
+    { 0xda01ebcf5f5432dcULL, 0x0c78 }, // a8b7
+    { 0xdab4ef781b2d696bULL, 0x0dbf }, // h8g7
+    { 0xdb5acc94f9640ca9ULL, 0x0af2 }, // c7d6
+    { 0xdb78ff212615a941ULL, 0x0240 }, // a1b2
+    { 0xdc72c6e2e87dc9fdULL, 0x0af2 }, // c7d6
+    { 0xdced642be14a4492ULL, 0x0af2 }, // c7d6
+    { 0xdd3d35ba76a0b3d4ULL, 0x0c78 }, // a8b7
+    { 0xdd6d21a6a59eac79ULL, 0x0ab1 }, // b7c6
+    { 0xdda297737f973ebbULL, 0x0c78 }, // a8b7
+    { 0xde6840ba4522d6aeULL, 0x0c78 }, // a8b7
+    { 0xdf39af9cb34a696aULL, 0x0c78 }, // a8b7
+    { 0xdfd4e1e29796e88dULL, 0x0b35 }, // f7e6
+    { 0xe03a4838b829b417ULL, 0x0c78 }, // a8b7
+    { 0xe115eb488a14ddfbULL, 0x0240 }, // a1b2
+    { 0xe251ef76ffa548feULL, 0x0bb6 }, // g7g6
+    { 0xe318c70b26badfd0ULL, 0x0dbf }, // h8g7
+    { 0xe31a45b9cf0985f7ULL, 0x0dbf }, // h8g7
+    { 0xe3296b8f83bbced0ULL, 0x0af2 }, // c7d6
+    { 0xe33a8d06b4470addULL, 0x0240 }, // a1b2
+    { 0xe343a7f988cd90e5ULL, 0x0af2 }, // c7d6
+    { 0xe361d37e541b63a8ULL, 0x0dbf }, // h8g7
+    { 0xe3c70fca69b5da52ULL, 0x0c78 }, // a8b7
+    { 0xe424197e0f4e5ed8ULL, 0x0dbf }, // h8g7
+    { 0xe4bbbbb70679d3b7ULL, 0x0b35 }, // f7e6
+    { 0xe5308ad43fe46bc4ULL, 0x0c78 }, // a8b7
+    { 0xe633b9a28fb5c9fbULL, 0x0c78 }, // a8b7
+    { 0xe65abd1676d7ad7bULL, 0x0c78 }, // a8b7
+    { 0xe68575d739d8a8f9ULL, 0x0dbf }, // h8g7
+    { 0xe69da9d78e6bf97eULL, 0x0b35 }, // f7e6
+    { 0xe6c501e7d2088cfeULL, 0x0af2 }, // c7d6
+    { 0xe8367586b5eef73cULL, 0x0240 }, // a1b2
+    { 0xe8ab763d4be5bb33ULL, 0x0dbf }, // h8g7
+    { 0xea30e281e75fa33fULL, 0x0dbf }, // h8g7
+    { 0xeaadd4ccbe41477bULL, 0x0c78 }, // a8b7
+    { 0xeadc0c78f090727cULL, 0x0af2 }, // c7d6
+    { 0xebd2a1ff22a917f9ULL, 0x0240 }, // a1b2
+    { 0xec6bfd564d11e7edULL, 0x0b35 }, // f7e6
+    { 0xed0ea8709e824b1cULL, 0x0c78 }, // a8b7
+    { 0xed910ab997b5c673ULL, 0x0c78 }, // a8b7
+    { 0xedd160b1d18d4e9eULL, 0x0b35 }, // f7e6
+    { 0xede90c201b88c998ULL, 0x0af2 }, // c7d6
+    { 0xee4231cf15a14ea0ULL, 0x0dbf }, // h8g7
+    { 0xef497265d3828c2aULL, 0x0af2 }, // c7d6
+    { 0xef72989cb732d194ULL, 0x0af2 }, // c7d6
+    { 0xef78dee176839d2aULL, 0x0b35 }, // f7e6
+    { 0xef9e7665a0fd00d7ULL, 0x0dbf }, // h8g7
+    { 0xefc6de55fc9e7557ULL, 0x0af2 }, // c7d6
+    { 0xeff7435c5e2eb417ULL, 0x0dbf }, // h8g7
+    { 0xf03c1eef5a446e5bULL, 0x0b35 }, // f7e6
+    { 0xf0dbbabfdf4eecdfULL, 0x0dbf }, // h8g7
+    { 0xf0e3d62e154b6bd9ULL, 0x0af2 }, // c7d6
+    { 0xf1594bc989d7c2aaULL, 0x0a70 }, // a7b6
+    { 0xf2402e0373f4f4d3ULL, 0x0dbf }, // h8g7
+    { 0xf24a687eb245b86dULL, 0x0c78 }, // a8b7
+    { 0xf2a40c3b584bacefULL, 0x0c78 }, // a8b7
+    { 0xf2acc0fa643b2590ULL, 0x0af2 }, // c7d6
+    { 0xf3708750d1676be7ULL, 0x0af2 }, // c7d6
+    { 0xf599c0a28f239e74ULL, 0x0c78 }, // a8b7
+    { 0xf5d8b8463787a50aULL, 0x0dbf }, // h8g7
+    { 0xf652e21d42e0bfa5ULL, 0x0bb6 }, // g7g6
+    { 0xf702541e23998678ULL, 0x0af2 }, // c7d6
+    { 0xf7076201a29d2c70ULL, 0x0af2 }, // c7d6
+    { 0xf7eebae73456573bULL, 0x0dbf }, // h8g7
+    { 0xf7ef0cb1e5d4ee2eULL, 0x0dbf }, // h8g7
+    { 0xfb680b89b211883cULL, 0x0dbf }, // h8g7
+    { 0xfbaf1f484aaddc39ULL, 0x0af2 }, // c7d6
+    { 0xfbb7c348fd1e8dbeULL, 0x0c78 }, // a8b7
+    { 0xfbf78814159a35e5ULL, 0x0c78 }, // a8b7
+    { 0xfc275dd74ed2f8bcULL, 0x0240 }, // a1b2
+    { 0xfc40d6dd73c22277ULL, 0x0c78 }, // a8b7
+    { 0xfc54d5fc9be50934ULL, 0x0dbf }, // h8g7
+    { 0xfccb773592d2845bULL, 0x0dbf }, // h8g7
+    { 0xfd08fea77cef9150ULL, 0x0dbf }, // h8g7
+    { 0xfe1bdd10477deb97ULL, 0x0dbf }, // h8g7
+    { 0xfe28f3260bcfa0b0ULL, 0x0c78 }, // a8b7
+    { 0xfe2a7194e27cfa97ULL, 0x0c78 }, // a8b7
+    { 0xfe4375201b1e9e17ULL, 0x0c78 }, // a8b7
+    { 0xfe9440ad6fd0c2aaULL, 0x0b35 }, // f7e6
+    { 0xfeb5cd6546a3db12ULL, 0x0af2 }, // c7d6
+    { 0xfef5b955ad73ff15ULL, 0x0dbf }, // h8g7
+}};
+
+} // namespace Book
+
+#endif
@@ -0,0 +1,134 @@
+#include "types.h"
+#include "book.h"
+#include "breakthrough.h"
+#include "smp.h"
+#include "tt.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Offline opening book builder
+ *
+ * Usage: book_gen [depth] [plies] [threads] [output]
+ *
+ * Every position of the first `plies' plies where one side plays its book
+ * moves while the other side plays anything is searched at depth `depth'
+ * with the Lazy SMP search, and the best moves are written as a sorted
+ * constexpr table to `output' (book_data.h by default) to be embedded
+ * in the agent. Both sides get their book in the same table.
+ */
+namespace {
+
+    int s_depth = 8;
+    int book_plies = 4;
+    int n_threads = SMP::default_threads();
+
+    std::map<Key, Move> book;
+    int n_searched = 0;
+
+    Move book_move(Game& game) {
+        auto it = book.find(game.key());
+        if (it != book.end())
+            return it->second;
+
+        auto start = std::chrono::steady_clock::now();
+        SMP::Result res = SMP::search(game, s_depth, n_threads);
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cerr << ++n_searched << ": "
+                  << Game::view_move(res.move)
+                  << " score " << res.score
+                  << " depth " << res.depth
+                  << " time " << secs << "s"
+                  << std::endl;
+
+        book[game.key()] = res.move;
+        return res.move;
+    }
+
+    /** Expand the positions where `book_side' plays its book moves */
+    void expand(Game& game, Player book_side, int ply, StateInfo* st) {
+        if (ply == book_plies || game.is_won())
+            return;
+
+        if (game.player_to_move() == book_side) {
+            Move move = book_move(game);
+            game.apply(move, *st);
+            expand(game, book_side, ply + 1, st + 1);
+            game.undo(move);
+            return;
+        }
+
+        game.compute_valid_moves();
+        auto [beg, end] = game.valid_moves();
+        std::vector<Move> moves(beg, end);
+
+        for (const auto& move : moves) {
+            game.apply(move, *st);
+            expand(game, book_side, ply + 1, st + 1);
+            game.undo(move);
+        }
+    }
+
+    void write_header(std::ostream& out) {
+        out << "#ifndef __BOOK_DATA_H_\n"
+            << "#define __BOOK_DATA_H_\n\n"
+            << "// Generated by book_gen: depth " << s_depth
+            << ", " << book_plies << " plies\n\n"
+            << "#include \"book.h\"\n\n"
+            << "#include <array>\n\n"
+            << "namespace Book {\n\n"
+            << "constexpr std::array<Entry, " << book.size() << "> entries {{\n";
+
+        // std::map keeps the keys sorted
+        for (const auto& [key, move] : book) {
+            out << "    { 0x" << std::hex << std::setw(16) << std::setfill('0') << key
+                << "ULL, 0x" << std::setw(4) << pack_move(move) << std::dec
+                << " }, // " << Game::view_move(move) << '\n';
+        }
+
+        out << "}};\n\n"
+            << "} // namespace Book\n\n"
+            << "#endif\n";
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        s_depth = std::stoi(argv[1]);
+    if (argc > 2)
+        book_plies = std::stoi(argv[2]);
+    if (argc > 3 && std::stoi(argv[3]) > 0)
+        n_threads = std::stoi(argv[3]);
+    std::string output = argc > 4 ? argv[4] : "book_data.h";
+
+    TT.resize(256);
+
+    StateInfo states[max_depth];
+    for (Player side : { Player::White, Player::Black }) {
+        Game game;
+        expand(game, side, 0, &states[0]);
+    }
+
+    std::ofstream ofs { output };
+    if (!ofs) {
+        std::cerr << "failed to open output file "
+            << output << std::endl;
+        return EXIT_FAILURE;
+    }
+    write_header(ofs);
+
+    std::cerr << "Wrote " << book.size()
+              << " positions to " << output << std::endl;
+
+    return EXIT_SUCCESS;
+}
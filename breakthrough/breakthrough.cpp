@@ -5,46 +5,61 @@
 
 #include "types.h"
 #include "breakthrough.h"
+#include "eval_params.h"
 
 namespace {
 
     /**
      * Pawn-Square Table to give base value to
-     * pawns on the grid.
-     * More value for pawns having wider scope.
+     * pawns on the grid (see eval_params.h).
      *
-     * NOTE: call PawnTable[row][col]
-     * TODO: Store that in breakthrough.cpp and keep the value
-     * contributed by this table as we apply/undo moves
+     * NOTE: The value contributed by this table is kept in the
+     * StateInfo::board_score as we apply/undo moves
      */
-    constexpr int pawn_square[height][width] = {
-        { -1,  0,  0, -1, -1,  0,  0, -1 },  // rank 0
-        {  2,  4,  5,  7,  7,  5,  4,  2 },
-        {  4,  8, 10, 15, 15, 10,  8,  4 },
-        {  6, 10, 15, 20, 20, 15, 10,  6 },
-        {  7, 12, 20, 25, 25, 20, 12,  7 },
-        { 10, 15, 25, 30, 30, 25, 15, 10 },
-        { 45, 50, 50, 50, 50, 50, 50, 45 },
-        {  0,  0,  0,  0,  0,  0,  0,  0 },  // rank 8
-    };
+    using Eval::Bonus::pawn_square;
 
-    constexpr int pawn_value { 100 };
-    
-    StateInfo root_state {
-        0,           // ply
-        0,           // board_score
-        0,           // mat_imba
-        false,       // is_capture
-        nullptr      // prev
+    /**
+     * Zobrist keys for each (player, square) pair and for the side to move.
+     *
+     * NOTE: Generated at compile time with a fixed seed so that keys
+     * are the same from one build to the next.
+     */
+    struct Zobrist {
+        Key psq[2][Nsquares];
+        Key side;
     };
-    int n_legal_moves;
-    std::vector<Move> m_valid_moves;
-    std::vector<Square> square_buf;
-    std::string m_buf;
-    std::string view_buf;
-    std::string ssquare_buf;
-    std::string smove_buf;
-    Square offsets[2][3] {
+
+    constexpr Zobrist make_zobrist() {
+        Zobrist z {};
+        Key s = 1070372ULL;
+        auto rand64 = [&s]() {
+            s ^= s >> 12;
+            s ^= s << 25;
+            s ^= s >> 27;
+            return s * 2685821657736338717ULL;
+        };
+        for (auto& keys : z.psq)
+            for (auto& k : keys)
+                k = rand64();
+        z.side = rand64();
+        return z;
+    }
+
+    constexpr Zobrist zobrist = make_zobrist();
+
+    constexpr Key psq_key(Player p, const Square& s) {
+        return zobrist.psq[p == Player::White ? 0 : 1][s.col + s.row * width];
+    }
+
+    /**
+     * Buffers backing the string_views returned by the views, one per
+     * thread so that games can be used concurrently.
+     */
+    thread_local std::string view_buf;
+    thread_local std::string ssquare_buf;
+    thread_local std::string smove_buf;
+
+    constexpr Square offsets[2][3] {
     { { -1, 1 }, { 0, 1 }, { 1, 1 } }, // Moves for white
     { { -1, -1 }, { 0, -1 }, { 1, -1 } } // Moves for black
 };
@@ -56,7 +71,8 @@ std::ostream& operator<<(std::ostream& out, const Square square);
 std::ostream& operator<<(std::ostream& out, const Move move);
 
 Game::Game()
-    : st{&root_state}
+    : root_state{}
+    , st{&root_state}
 {
     m_grid.fill(Cell::Empty);
     for (int y = 0; y < height + 2; ++y) {
@@ -68,17 +84,71 @@ Game::Game()
     for (int y : { 0, 1 }) {
         for (int x = 0; x < 8; ++x) {
             cell_at(x, y) = Cell::White;
-            st->board_score += pawn_square[y][x]; 
         }
     }
     for (int y : { 6, 7 }) {
         for (int x = 0; x < 8; ++x) {
             cell_at(x, y) = Cell::Black;
-            st->board_score += relative_score(Player::Black, pawn_square[relative_row(Player::Black, y)][x]);
         }
     }
     n_turns = 0;
     m_player_to_move = Player::White;
+    m_player = Player::White;
+    init_state_info();
+}
+
+void Game::init_state_info() {
+    st->board_score = 0;
+    st->mat_imba = 0;
+    st->key = m_player_to_move == Player::Black ? zobrist.side : 0;
+    m_pieces.fill(0);
+
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            Cell c = cell_at(col, row);
+            if (c != Cell::White && c != Cell::Black)
+                continue;
+            Player p = player_of(c);
+            st->board_score += relative_score(p, pawn_square[relative_row(p, row)][col]);
+            st->mat_imba += relative_score(p, pawn_value);
+            st->key ^= psq_key(p, { col, row });
+            m_pieces[p == Player::White ? 0 : 1] |= square_bb({ col, row });
+        }
+    }
+}
+
+/**
+ * A copy starts a new history at the current position of `other',
+ * so moves played before the copy can't be undone on it.
+ */
+Game::Game(const Game& other)
+    : m_grid{ other.m_grid }
+    , m_pieces{ other.m_pieces }
+    , n_turns{ other.n_turns }
+    , m_player_to_move{ other.m_player_to_move }
+    , m_player{ other.m_player }
+    , root_state{ *other.st }
+    , st{ &root_state }
+    , n_legal_moves{ other.n_legal_moves }
+    , m_valid_moves{ other.m_valid_moves }
+{
+    root_state.prev = nullptr;
+}
+
+Game& Game::operator=(const Game& other) {
+    if (this == &other)
+        return *this;
+    m_grid = other.m_grid;
+    m_pieces = other.m_pieces;
+    n_turns = other.n_turns;
+    m_player_to_move = other.m_player_to_move;
+    m_player = other.m_player;
+    root_state = *other.st;
+    root_state.prev = nullptr;
+    st = &root_state;
+    n_legal_moves = other.n_legal_moves;
+    m_valid_moves = other.m_valid_moves;
+    return *this;
 }
 
 void Game::init(std::istream& is) {
@@ -87,8 +157,13 @@ void Game::init(std::istream& is) {
 
     std::getline(is, m_buf);
     if (m_buf[0] != 'N') {
+        // The opponent's first move becomes the root of the history
         Move move = get_move(m_buf);
-        apply(move, root_state);
+        StateInfo first_state;
+        apply(move, first_state);
+        root_state = first_state;
+        root_state.prev = nullptr;
+        st = &root_state;
     }
     is >> n_legal_moves;
     is.ignore();
@@ -135,6 +210,7 @@ void Game::set_board(std::string_view s, Player to_move) {
         }
     }
     m_player_to_move = to_move;
+    init_state_info();
 }
 
 std::string_view Game::view_square(const Square& sq)
@@ -217,18 +293,23 @@ void Game::apply(const Move& move, StateInfo& _st)
 
     Cell cell = Cell::Empty;
     Player p = m_player_to_move;
+    const int us = p == Player::White ? 0 : 1;
 
     // Record basic data into the new StateInfo object
     _st.ply = st->ply + 1;
     _st.is_capture = is_capture(move);
     _st.board_score = st->board_score;
     _st.mat_imba = st->mat_imba;
-    
+    _st.key = st->key ^ zobrist.side ^ psq_key(p, move.from) ^ psq_key(p, move.to);
+
     if (_st.is_capture) {
         // add score if opponent is black, remove it if white
         _st.board_score -= relative_score(!p, pawn_square[relative_row(!p, move.to.row)][move.to.col]);
         _st.mat_imba -= relative_score(!p, pawn_value);
+        _st.key ^= psq_key(!p, move.to);
+        m_pieces[1 - us] ^= square_bb(move.to);
     }
+    m_pieces[us] ^= square_bb(move.from) | square_bb(move.to);
 
     // Make the move on the grid
     std::swap(cell, cell_at(move.from.col, move.from.row));
@@ -262,6 +343,11 @@ void Game::undo(const Move& move)
 
     assert(cell_at(move.from.col, move.from.row) == cell_of(!player_to_move()));
 
+    const int us = player_to_move() == Player::White ? 0 : 1;
+    m_pieces[1 - us] ^= square_bb(move.from) | square_bb(move.to);
+    if (st->is_capture)
+        m_pieces[us] ^= square_bb(move.to);
+
     --n_turns;
     st = st->prev;
 
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <iosfwd>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -14,6 +15,7 @@ struct StateInfo {
     int board_score;
     int mat_imba;
     bool is_capture;
+    Key key;
     StateInfo* prev;
 };
 
@@ -25,6 +27,8 @@ public:
     using square_range = std::pair<square_iterator, square_iterator>;
 
     Game();
+    Game(const Game&);
+    Game& operator=(const Game&);
     void init(std::istream&);
     void turn_init(std::istream&, StateInfo&);
     void set_board(std::string_view, Player to_move);
@@ -40,6 +44,8 @@ public:
     Player player_to_move() const;
     constexpr int board_score() const;
     constexpr int material_imbalance() const;
+    Key key() const;
+    constexpr Bitboard pieces(Player) const;
 
     bool is_capture(const Move&) const;
     int turn_number() const;
@@ -56,13 +62,22 @@ public:
 
 private:
     std::array<Cell, (width + 2) * (height + 2)> m_grid;
+    std::array<Bitboard, 2> m_pieces;
     int n_turns;
     Player m_player_to_move;
     Player m_player;
+    StateInfo root_state;
     StateInfo* st;
 
+    int n_legal_moves;
+    mutable std::vector<Move> m_valid_moves;
+    mutable std::vector<Square> square_buf;
+    std::string m_buf;
+
     static Move get_move(std::string_view);
     constexpr Cell& cell_at(int col, int row);
+    /** Recompute the bitboards and the incremental data of the current StateInfo from the grid */
+    void init_state_info();
 };
 
 inline bool Game::is_capture(const Move& move) const {
@@ -95,12 +110,14 @@ constexpr int Game::board_score() const {
 constexpr int Game::material_imbalance() const {
     return st->mat_imba;
 }
+inline Key Game::key() const {
+    return st->key;
+}
+constexpr Bitboard Game::pieces(Player p) const {
+    return m_pieces[p == Player::White ? 0 : 1];
+}
 template<Player P>
 constexpr bool Game::has_won() const {
-    for (int x = 0; x < width; ++x) {
-        if (cell_at(x, relative_row(P, 7)) == cell_of(P))
-            return true;
-    }
-    return false;
+    return pieces(P) & rank_bb(relative_row(P, 7));
 }
 #endif
@@ -1,8 +1,11 @@
 #include "eval.h"
+#include "eval_params.h"
 #include "breakthrough.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <type_traits>
 #include <string>
@@ -15,32 +18,12 @@ namespace {
     enum class Tracing { None, Trace };
 }
 
+/**
+ * The tunable bonuses are in eval_params.h, this is the hack for
+ * decided games, see evaluate_passed_pawns()
+ */
 namespace Bonus {
 
-    /**
-     * Bonus point for a lever by rank
-     *
-     * NOTE: a lever at low-mid rank removes valuable opponent pawn
-     * if he captures (can most likely be recaptured too) and lets us
-     * disrupt their pawn structure if needed
-     */
-    constexpr int Lever[height] { 0, 0, 30, 15, 0, 0, 0, 0 };
-
-    /**
-     * Bonus points per supporting pawn
-     */
-    constexpr int Support { 17 };
-
-    /**
-     * Bonus points for a having two pawns side by side per rank
-     *
-     * NOTE: -3 on rank 3 is to avoid biaising the first few moves
-     * Should experiment with this, in particular, it should be
-     * dynamically changing since as the game goes on, pawns move up
-     * and phalanx are important for defense
-     */
-    constexpr int Phalanx[height] { 7, 8, 12, 21, 25, 100, 250, 0 };
-
     constexpr int passed_pawned[height] { 0, 0, 0, 0, 0, 32000 - 3, 32000 - 1, -32000 };
 
 } // namespace Bonus
@@ -67,24 +50,37 @@ private:
     template<Player P>
     int evaluate_passed_pawns();
     template<Player P>
-    constexpr int lever_bonus(const Square& s);
+    int lever_bonus();
+    template<Player P>
+    int connected_bonus();
     template<Player P>
-    constexpr int connected_bonus(const Square& s);
+    int passed_bonus();
 };
 
     /**
-     * Bonus points for a pawn giving rise to a lever
+     * Sum of the bonus of each pawn in `b' according to its (relative) rank
+     */
+    template<Player P>
+    constexpr int rank_bonus(Bitboard b, const int (&bonus)[height]) {
+        int ret = 0;
+        for (int row = 0; row < height; ++row)
+            ret += popcount(b & rank_bb(row)) * bonus[relative_row(P, row)];
+        return ret;
+    }
+
+    /**
+     * Bonus points for pawns giving rise to a lever
      *
-     * i.e. a pawn having an opponent's pawn diagonally
+     * i.e. pawns having an opponent's pawn diagonally
+     *
+     * NOTE: a lever at low-mid rank removes valuable opponent pawn
+     * if he captures (can most likely be recaptured too) and lets us
+     * disrupt their pawn structure if needed
      */
     template<Tracing T> template<Player P>
-    constexpr int Evaluation<T>::lever_bonus(const Square& s) {
-        bool lever = false;
-        for (auto dx : { -1, 1 })
-            lever |= game.cell_at(
-                s.col + dx,
-                s.row + (P == Player::White ? 1 : - 1)) == cell_of(!P);
-        return lever * Bonus::Lever[relative_row(P, s.row)];
+    int Evaluation<T>::lever_bonus() {
+        Bitboard levers = game.pieces(P) & pawn_attacks<!P>(game.pieces(!P));
+        return rank_bonus<P>(levers, Bonus::Lever);
     }
 
     /**
@@ -96,45 +92,40 @@ private:
      * 3. (Relative) rank of the pawn
      */
     template<Tracing T> template<Player P>
-    constexpr int Evaluation<T>::connected_bonus(const Square& s) {
-        int support = 0;
-        bool phalanx = false;
-        for (const auto dx : { -1, 1 }) {
-            support += game.cell_at(
-                s.col + dx,
-                s.row + (P == Player::White ? -1 : 1)) == cell_of(P);
-            phalanx |= game.cell_at(
-                s.col + dx,
-                s.row) == cell_of(P);
-        }
-        bool opposed = false;
-        for (auto [it, end] = game.pawns_of(!P); it != end; ++it) {
-            if (it->col == s.col) {
-                opposed = true;
-                break;
-            }
-        }
-        return support * Bonus::Support + phalanx * Bonus::Phalanx[relative_row(P, s.row)];
+    int Evaluation<T>::connected_bonus() {
+        const Bitboard pawns = game.pieces(P);
+        const Bitboard ahead = shift_forward<P>(pawns);
+
+        // A pawn's supporters are the pawns attacking its square
+        int support = popcount(pawns & shift_east(ahead))
+            + popcount(pawns & shift_west(ahead));
+
+        Bitboard phalanx = pawns & (shift_east(pawns) | shift_west(pawns));
+
+        return support * Bonus::Support + rank_bonus<P>(phalanx, Bonus::Phalanx);
+    }
+
+    /**
+     * Bonus points for pawns with no opponent's pawn in front of them
+     * on their file or the adjacent ones
+     */
+    template<Tracing T> template<Player P>
+    int Evaluation<T>::passed_bonus() {
+        Bitboard passed = passed_pawns<P>(game.pieces(P), game.pieces(!P));
+        return rank_bonus<P>(passed, Bonus::Passed);
     }
 
     template<Tracing T> template<Player P>
     int Evaluation<T>::evaluate_passed_pawns() {
-        int score = 0;
         // Check for lost game
-        for (int x = 0; x < width; ++x) {
-            if (game.cell_at(x, relative_row(P, 0)) == cell_of(!P)) {
-                score = Bonus::passed_pawned[7];
-                break;
-            }
-        }
-        for (auto [it, end] = game.pawns_of(P); it != end; ++it) {
-            if (relative_row(P, it->row) == 6 && game.player_to_move() == P) {
-                // We win this turn
-                score = Bonus::passed_pawned[6];
-                break;
-            }
-        }
-        return score;
+        if (game.pieces(!P) & rank_bb(relative_row(P, 0)))
+            return Bonus::passed_pawned[7];
+
+        // We win this turn
+        if (game.player_to_move() == P && (game.pieces(P) & rank_bb(relative_row(P, 6))))
+            return Bonus::passed_pawned[6];
+
+        return 0;
     }
 
 
@@ -156,15 +147,9 @@ private:
 
         score += game.board_score() + game.material_imbalance();
 
-        for (auto [it, end] = game.pawns_of(Player::White); it != end; ++it) {
-            score += connected_bonus<Player::White>(*it);
-            score += lever_bonus<Player::White>(*it);
-        }
-
-        for (auto [it, end] = game.pawns_of(Player::Black); it != end; ++it) {
-            score -= connected_bonus<Player::Black>(*it);
-            score -= lever_bonus<Player::Black>(*it);
-        }
+        score += connected_bonus<Player::White>() - connected_bonus<Player::Black>();
+        score += lever_bonus<Player::White>() - lever_bonus<Player::Black>();
+        score += passed_bonus<Player::White>() - passed_bonus<Player::Black>();
 
         return game.player_to_move() == Player::White ? score : -score;
     }
@@ -183,7 +168,7 @@ private:
         int wpp_eval = evaluate_passed_pawns<Player::White>();
         int bpp_eval = evaluate_passed_pawns<Player::Black>();
 
-        if (std::max(abs(wpp_eval), abs(bpp_eval)) >= 32000 - 1) {
+        if (std::max(abs(wpp_eval), abs(bpp_eval)) >= 32000 - max_depth) {
             int ret = game.player_to_move() == Player::White ? wpp_eval : bpp_eval;
 
             out << "\n\n        WHITE:"
@@ -197,32 +182,29 @@ private:
             return ret;
         }
 
-        int wconnected = 0, bconnected = 0,
-            wlever     = 0, blever     = 0;
-
-        for (auto [it, end] = game.pawns_of(Player::White); it != end; ++it) {
-            wconnected += connected_bonus<Player::White>(*it);
-            wlever     += lever_bonus<Player::White>(*it);
-        }
-
-        for (auto [it, end] = game.pawns_of(Player::Black); it != end; ++it) {
-            bconnected += connected_bonus<Player::Black>(*it);
-            blever     += lever_bonus<Player::Black>(*it);
-        }
+        int wconnected = connected_bonus<Player::White>();
+        int bconnected = connected_bonus<Player::Black>();
+        int wlever     = lever_bonus<Player::White>();
+        int blever     = lever_bonus<Player::Black>();
+        int wpassed    = passed_bonus<Player::White>();
+        int bpassed    = passed_bonus<Player::Black>();
 
-        score += wpp_eval - bpp_eval + wconnected - bconnected + wlever - blever;
+        score += wpp_eval - bpp_eval + wconnected - bconnected
+            + wlever - blever + wpassed - bpassed;
 
         out << "\n\n        WHITE:"
             << "\n    evaluate_passed_pawns: " << wpp_eval
             << "\n    connected_bonus: "       << wconnected
             << "\n    lever_bonus: "           << wlever
-            << "\n    WHITE TOTAL: "           << wpp_eval + wconnected + wlever
+            << "\n    passed_bonus: "          << wpassed
+            << "\n    WHITE TOTAL: "           << wpp_eval + wconnected + wlever + wpassed
             << "\n\n"
             << "\n        BLACK:"
             << "\n    evaluate_passed_pawns: " << -bpp_eval
             << "\n    connected_bonus: "       << -bconnected
             << "\n    lever_bonus: "           << -blever
-            << "\n    BLACK TOTAL: "           << -(bpp_eval + bconnected + blever)
+            << "\n    passed_bonus: "          << -bpassed
+            << "\n    BLACK TOTAL: "           << -(bpp_eval + bconnected + blever + bpassed)
             << "\n"
             << "\nTOTAL SCORE RETURNED: "      << relative_score(game.player_to_move(), score)
             << '\n';
@@ -247,3 +229,43 @@ std::pair<int, std::string> Eval::trace(const Game& game) {
     int score = eval.score();
     return { score, eval.view_trace() };
 }
+
+namespace {
+
+    template<Player P>
+    void add_rank_coefficients(Bitboard b, int* coeffs) {
+        for (int row = 0; row < height; ++row)
+            coeffs[relative_row(P, row)] += relative_score(P, popcount(b & rank_bb(row)));
+    }
+
+    template<Player P>
+    void add_coefficients(const Game& game, std::array<int, Eval::Param::Count>& coeffs) {
+        using namespace Eval;
+
+        const Bitboard pawns = game.pieces(P);
+        const Bitboard theirs = game.pieces(!P);
+        const Bitboard ahead = shift_forward<P>(pawns);
+
+        for (Bitboard b = pawns; b; ) {
+            Square s = square_of(pop_lsb(b));
+            coeffs[Param::PawnSquare + s.col + relative_row(P, s.row) * width] += relative_score(P, 1);
+        }
+
+        add_rank_coefficients<P>(pawns & pawn_attacks<!P>(theirs), &coeffs[Param::Lever]);
+
+        coeffs[Param::Support] += relative_score(P, popcount(pawns & shift_east(ahead))
+                                                 + popcount(pawns & shift_west(ahead)));
+
+        add_rank_coefficients<P>(pawns & (shift_east(pawns) | shift_west(pawns)), &coeffs[Param::Phalanx]);
+
+        add_rank_coefficients<P>(passed_pawns<P>(pawns, theirs), &coeffs[Param::Passed]);
+    }
+
+}  // namespace
+
+std::array<int, Eval::Param::Count> Eval::coefficients(const Game& game) {
+    std::array<int, Param::Count> ret {};
+    add_coefficients<Player::White>(game, ret);
+    add_coefficients<Player::Black>(game, ret);
+    return ret;
+}
@@ -1,6 +1,7 @@
 #ifndef __EVAL_H_
 #define __EVAL_H_
 
+#include <array>
 #include <string>
 
 #include "types.h"
@@ -13,6 +14,25 @@ int evaluate(const Game& game);
 
 std::pair<int, std::string> trace(const Game& game);
 
+/**
+ * Index of each parameter of eval_params.h in a flat vector, for the tuner
+ */
+namespace Param {
+    constexpr int PawnSquare = 0;
+    constexpr int Lever = PawnSquare + Nsquares;
+    constexpr int Support = Lever + height;
+    constexpr int Phalanx = Support + 1;
+    constexpr int Passed = Phalanx + height;
+    constexpr int Count = Passed + height;
+} // namespace Param
+
+/**
+ * Coefficient of each parameter in the evaluation of a position from White's
+ * point of view, i.e. if the game isn't decided, that evaluation is the material
+ * imbalance plus the dot product of the coefficients with the parameters
+ */
+std::array<int, Param::Count> coefficients(const Game& game);
+
 } // namespace Eval
 
 #endif
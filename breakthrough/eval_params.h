@@ -0,0 +1,40 @@
+#ifndef __EVAL_PARAMS_H_
+#define __EVAL_PARAMS_H_
+
+#include "types.h"
+
+// Hand-set values, regenerate with the tuner (see tune.cpp)
+
+namespace Eval::Bonus {
+
+    /**
+     * Pawn-square table giving a base value to pawns on the grid
+     *
+     * NOTE: call pawn_square[row][col] with the row relative to the pawn's owner
+     */
+    constexpr int pawn_square[height][width] = {
+        {  -1,   0,   0,  -1,  -1,   0,   0,  -1 },
+        {   2,   4,   5,   7,   7,   5,   4,   2 },
+        {   4,   8,  10,  15,  15,  10,   8,   4 },
+        {   6,  10,  15,  20,  20,  15,  10,   6 },
+        {   7,  12,  20,  25,  25,  20,  12,   7 },
+        {  10,  15,  25,  30,  30,  25,  15,  10 },
+        {  45,  50,  50,  50,  50,  50,  50,  45 },
+        {   0,   0,   0,   0,   0,   0,   0,   0 },
+    };
+
+    /** Bonus points for a lever by rank */
+    constexpr int Lever[height] { 0, 0, 30, 15, 0, 0, 0, 0 };
+
+    /** Bonus points per supporting pawn */
+    constexpr int Support { 17 };
+
+    /** Bonus points for having two pawns side by side by rank */
+    constexpr int Phalanx[height] { 7, 8, 12, 21, 25, 100, 250, 0 };
+
+    /** Bonus points for a passed pawn by rank */
+    constexpr int Passed[height] { 0, 0, 5, 10, 20, 40, 0, 0 };
+
+} // namespace Eval::Bonus
+
+#endif
@@ -0,0 +1,81 @@
+#include "smp.h"
+#include "agent.h"
+#include "breakthrough.h"
+#include "tt.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace {
+
+    /**
+     * Depth at which helper `idx' starts its iterative deepening
+     *
+     * NOTE: Staggering the depths makes the helpers work on different
+     * iterations than the main thread (and than each other), which is
+     * what fills the table with useful entries ahead of it.
+     */
+    constexpr int helper_start_depth(int idx) {
+        return 1 + idx % 3;
+    }
+
+    /** Helpers keep searching past the main thread's depth until they are stopped */
+    constexpr int helper_extra_depth = 4;
+
+}  // namespace
+
+int SMP::default_threads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+SMP::Result SMP::search(const Game& game, int s_depth, int n_threads)
+{
+    n_threads = std::max(1, n_threads);
+
+    TT.new_search();
+
+    std::atomic<bool> stop { false };
+
+    // Each thread gets its own copy of the game and its own agent
+    std::vector<std::unique_ptr<Game>> games;
+    std::vector<std::unique_ptr<Agent>> agents;
+    for (int i = 0; i < n_threads; ++i) {
+        games.push_back(std::make_unique<Game>(game));
+        games.back()->compute_valid_moves();
+        agents.push_back(std::make_unique<Agent>(*games.back()));
+    }
+
+    std::vector<Move> helper_moves(n_threads, Move_None);
+    std::vector<std::thread> helpers;
+    for (int i = 1; i < n_threads; ++i) {
+        agents[i]->set_helper(&stop);
+        helpers.emplace_back([&agent = *agents[i], &move = helper_moves[i], i, s_depth] {
+            move = agent.iterative_deepening(helper_start_depth(i), s_depth + helper_extra_depth);
+        });
+    }
+
+    Move main_move = agents[0]->iterative_deepening(0, s_depth);
+
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& th : helpers)
+        th.join();
+
+    Result ret { main_move, agents[0]->best_score(), agents[0]->completed_depth(), 0 };
+
+    // Prefer the result of a helper that completed a deeper iteration
+    for (int i = 1; i < n_threads; ++i) {
+        const Agent& agent = *agents[i];
+        if (agent.completed_depth() > ret.depth) {
+            ret.depth = agent.completed_depth();
+            ret.score = agent.best_score();
+            ret.move = helper_moves[i];
+        }
+    }
+
+    for (const auto& agent : agents)
+        ret.nodes += agent->nodes();
+
+    return ret;
+}
@@ -0,0 +1,35 @@
+#ifndef __SMP_H_
+#define __SMP_H_
+
+#include "types.h"
+
+#include <thread>
+
+class Game;
+
+namespace SMP {
+
+struct Result {
+    Move move;
+    int score;
+    int depth;
+    long long nodes;
+};
+
+/** Number of threads used when none is specified: all available cores */
+int default_threads();
+
+/**
+ * Lazy SMP search of `game' at depth `search_depth'.
+ *
+ * The calling thread runs the main iterative deepening while `n_threads' - 1
+ * helpers search the same position on their own copy of the game, starting
+ * at staggered depths. They only communicate through the shared transposition
+ * table, which lets the main thread find most of its subtrees already searched.
+ * Helpers are stopped as soon as the main thread completes `search_depth'.
+ */
+Result search(const Game& game, int search_depth, int n_threads = default_threads());
+
+} // namespace SMP
+
+#endif
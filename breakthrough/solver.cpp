@@ -0,0 +1,207 @@
+#include "solver.h"
+#include "breakthrough.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace {
+
+    constexpr uint32_t pn_inf = 1u << 30;
+
+    /** The solver is used when there are at most that many pawns on the board */
+    constexpr int max_pawns = 10;
+
+    /** Number of expansions between two looks at the clock (a power of 2) */
+    constexpr long long clock_period = 256;
+
+    constexpr uint32_t sat_add(uint32_t a, uint32_t b) {
+        return static_cast<uint32_t>(std::min<uint64_t>(pn_inf, uint64_t(a) + b));
+    }
+
+    /** Does the side to move have a pawn one step away from winning? */
+    bool wins_next_move(const Game& game) {
+        Player us = game.player_to_move();
+        return game.pieces(us) & rank_bb(relative_row(us, 6));
+    }
+
+    /** Moves the most advanced of the pawns of P needs to reach the last row */
+    template<Player P>
+    int moves_to_promote(Bitboard pawns) {
+        if (!pawns)
+            return 8;
+        return P == Player::White ? 7 - (std::bit_width(pawns) - 1) / 8
+                                  : lsb(pawns) / 8;
+    }
+
+    /**
+     * Does a passed pawn of P, P to move, promote no later than the
+     * opponent's passed pawns? Nothing can stop a passed pawn other than
+     * the opponent winning first.
+     */
+    template<Player P>
+    bool wins_race(const Game& game) {
+        const Bitboard ours = game.pieces(P);
+        const Bitboard theirs = game.pieces(!P);
+        const Bitboard passed = passed_pawns<P>(ours, theirs);
+
+        return passed
+            && moves_to_promote<P>(passed) <= moves_to_promote<!P>(passed_pawns<!P>(theirs, ours));
+    }
+
+}  // namespace
+
+Solver::Solver(size_t _mb_size)
+    : mb_size{ _mb_size }
+    , mask{ 0 }
+    , game{ nullptr }
+    , nodes{ 0 }
+    , budget{ 0 }
+    , timed_out{ false }
+{
+}
+
+bool Solver::applicable(const Game& game) {
+    const Bitboard white = game.pieces(Player::White);
+    const Bitboard black = game.pieces(Player::Black);
+
+    if (popcount(white | black) <= max_pawns)
+        return true;
+
+    return game.player_to_move() == Player::White ? wins_race<Player::White>(game)
+                                                  : wins_race<Player::Black>(game);
+}
+
+void Solver::store(Key key, PnPair pn) {
+    Entry& e = table[key & mask];
+    e.key = key;
+    e.phi = pn.phi;
+    e.delta = pn.delta;
+}
+
+/**
+ * Proof and disproof numbers of the position just reached, as seen
+ * by its side to move. Positions decided within one move are detected
+ * here so that they never need to be expanded.
+ */
+Solver::PnPair Solver::child_pn() const {
+    if (game->is_won())
+        return { pn_inf, 0 };
+    if (wins_next_move(*game))
+        return { 0, pn_inf };
+
+    const Key key = game->key();
+    const Entry& e = table[key & mask];
+    if (e.key == key)
+        return { e.phi, e.delta };
+
+    return { 1, 1 };
+}
+
+/**
+ * Multiple iterative deepening: expand the most proving child until the
+ * node's proof or disproof number reaches its threshold.
+ *
+ * NOTE: Breakthrough positions can't repeat since pawns only move forward,
+ * so the search graph is acyclic and none of the usual df-pn problems with
+ * cycles arise.
+ */
+Solver::PnPair Solver::mid(uint32_t th_phi, uint32_t th_delta) {
+    ++nodes;
+    if (nodes % clock_period == 0 && Clock::now() >= deadline)
+        timed_out = true;
+
+    const Key key = game->key();
+
+    std::array<Move, max_n_moves> moves;
+    game->compute_valid_moves();
+    auto [beg, end] = game->valid_moves();
+    const int n_moves = std::distance(beg, end);
+    std::copy(beg, end, moves.begin());
+
+    StateInfo st;
+
+    while (true) {
+        // phi is the smallest disproof number of the children and delta
+        // the sum of their proof numbers
+        PnPair pn { pn_inf, 0 };
+        uint32_t best_phi = 0;
+        uint32_t delta2 = pn_inf;
+        int best = 0;
+
+        for (int i = 0; i < n_moves; ++i) {
+            game->apply(moves[i], st);
+            PnPair c = child_pn();
+            game->undo(moves[i]);
+
+            if (c.delta < pn.phi) {
+                delta2 = pn.phi;
+                pn.phi = c.delta;
+                best_phi = c.phi;
+                best = i;
+            }
+            else if (c.delta < delta2) {
+                delta2 = c.delta;
+            }
+            pn.delta = sat_add(pn.delta, c.phi);
+        }
+
+        if (pn.phi >= th_phi || pn.delta >= th_delta || nodes >= budget || timed_out) {
+            store(key, pn);
+            return pn;
+        }
+
+        uint32_t c_th_phi = sat_add(th_delta - pn.delta, best_phi);
+        uint32_t c_th_delta = std::min(th_phi, sat_add(delta2, 1));
+
+        game->apply(moves[best], st);
+        mid(c_th_phi, c_th_delta);
+        game->undo(moves[best]);
+    }
+}
+
+Solver::Result Solver::solve(Game& _game, long long node_budget, Clock::time_point _deadline) {
+    if (table.empty()) {
+        size_t n = 1;
+        while (2 * n * sizeof(Entry) <= mb_size * 1024 * 1024)
+            n *= 2;
+        table.assign(n, Entry{});
+        mask = n - 1;
+    }
+
+    game = &_game;
+    nodes = 0;
+    budget = node_budget;
+    deadline = _deadline;
+    timed_out = false;
+
+    PnPair root = mid(pn_inf, pn_inf);
+
+    Result ret { Status::Unknown, Move_None, nodes };
+
+    if (root.delta == 0) {
+        ret.status = Status::Loss;
+    }
+    else if (root.phi == 0) {
+        ret.status = Status::Win;
+
+        // Any child proven to be lost for the opponent is a winning move
+        StateInfo st;
+        game->compute_valid_moves();
+        for (auto [it, end] = game->valid_moves(); it != end; ++it) {
+            game->apply(*it, st);
+            PnPair c = child_pn();
+            game->undo(*it);
+
+            if (c.delta == 0) {
+                ret.move = *it;
+                break;
+            }
+        }
+        // The proof of that child may have been overwritten in the table
+        if (ret.move == Move_None)
+            ret.status = Status::Unknown;
+    }
+
+    return ret;
+}
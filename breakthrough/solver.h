@@ -0,0 +1,77 @@
+#ifndef __SOLVER_H_
+#define __SOLVER_H_
+
+#include "types.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Game;
+
+/**
+ * Depth-first proof-number (df-pn) solver for pawn races.
+ *
+ * Proves or disproves that the side to move wins, within a budget of
+ * nodes and a deadline. Proof and disproof numbers are kept in a fixed size hash table,
+ * which is allocated on the first call and kept between calls so that
+ * results carry over from one turn to the next.
+ */
+class Solver {
+public:
+    enum class Status {
+        Unknown,
+        Win,
+        Loss
+    };
+
+    struct Result {
+        Status status;
+        Move move;
+        long long nodes;
+    };
+
+    explicit Solver(size_t mb_size = 16);
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Whether the position is simple enough to be worth solving: few
+     * pawns, or a passed pawn of the side to move that wins the race
+     * against the opponent's passed pawns.
+     */
+    static bool applicable(const Game&);
+
+    /** `move' is a winning move when the status is Status::Win */
+    Result solve(Game&, long long node_budget, Clock::time_point deadline);
+
+private:
+    struct Entry {
+        Key key;
+        uint32_t phi;
+        uint32_t delta;
+    };
+
+    /** Proof and disproof numbers from the point of view of the side to move */
+    struct PnPair {
+        uint32_t phi;
+        uint32_t delta;
+    };
+
+    std::vector<Entry> table;
+    size_t mb_size;
+    size_t mask;
+
+    Game* game;
+    long long nodes;
+    long long budget;
+    Clock::time_point deadline;
+    bool timed_out;
+
+    PnPair mid(uint32_t th_phi, uint32_t th_delta);
+    PnPair child_pn() const;
+    void store(Key key, PnPair pn);
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include "tt.h"
+
+#include <algorithm>
+
+TranspositionTable TT { 16 };
+
+namespace {
+
+    /**
+     * Layout of the data word of an entry:
+     *
+     * bits  0-15: packed move
+     * bits 16-31: value
+     * bits 32-39: depth
+     * bits 40-41: bound
+     * bits 48-55: generation
+     */
+    constexpr uint64_t pack_data(uint16_t move, int value, int depth, Bound bound, uint8_t generation) {
+        return static_cast<uint64_t>(move)
+            | static_cast<uint64_t>(static_cast<uint16_t>(value)) << 16
+            | static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 32
+            | static_cast<uint64_t>(bound) << 40
+            | static_cast<uint64_t>(generation) << 48;
+    }
+    constexpr uint16_t data_move(uint64_t data) {
+        return static_cast<uint16_t>(data);
+    }
+    constexpr int data_value(uint64_t data) {
+        return static_cast<int16_t>(data >> 16);
+    }
+    constexpr int data_depth(uint64_t data) {
+        return static_cast<int8_t>(data >> 32);
+    }
+    constexpr Bound data_bound(uint64_t data) {
+        return static_cast<Bound>((data >> 40) & 3);
+    }
+    constexpr uint8_t data_generation(uint64_t data) {
+        return static_cast<uint8_t>(data >> 48);
+    }
+
+}  // namespace
+
+TranspositionTable::TranspositionTable(size_t mb_size)
+    : n_entries{ 0 }
+    , mask{ 0 }
+    , generation{ 0 }
+{
+    resize(mb_size);
+}
+
+/** Not thread-safe, to be called while no search is running */
+void TranspositionTable::resize(size_t mb_size) {
+    // Round down to a power of two so that indexing is a single mask
+    size_t n = 1;
+    while (2 * n * sizeof(Entry) <= mb_size * 1024 * 1024)
+        n *= 2;
+
+    table = std::make_unique<Entry[]>(n);
+    n_entries = n;
+    mask = n - 1;
+    clear();
+}
+
+/** Not thread-safe, to be called while no search is running */
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < n_entries; ++i) {
+        table[i].key_xor_data.store(0, std::memory_order_relaxed);
+        table[i].data.store(0, std::memory_order_relaxed);
+    }
+    generation = 0;
+}
+
+void TranspositionTable::new_search() {
+    ++generation;
+}
+
+TranspositionTable::Entry& TranspositionTable::entry(Key key) {
+    return table[key & mask];
+}
+
+const TranspositionTable::Entry& TranspositionTable::entry(Key key) const {
+    return table[key & mask];
+}
+
+bool TranspositionTable::probe(Key key, TTData& data) const {
+    const Entry& e = entry(key);
+    const uint64_t d = e.data.load(std::memory_order_relaxed);
+    const uint64_t k = e.key_xor_data.load(std::memory_order_relaxed);
+
+    if ((k ^ d) != key || data_bound(d) == Bound::None)
+        return false;
+
+    data.move = unpack_move(data_move(d));
+    data.value = data_value(d);
+    data.depth = data_depth(d);
+    data.bound = data_bound(d);
+    return true;
+}
+
+void TranspositionTable::store(Key key, int value, Bound bound, int depth, const Move& move) {
+    Entry& e = entry(key);
+    const uint64_t old_d = e.data.load(std::memory_order_relaxed);
+    const uint64_t old_k = e.key_xor_data.load(std::memory_order_relaxed);
+    const bool same_key = (old_k ^ old_d) == key;
+
+    // Keep deeper results of the current search about the same position,
+    // but always replace entries left over from previous searches
+    if (same_key && data_generation(old_d) == generation
+        && bound != Bound::Exact && depth < data_depth(old_d))
+        return;
+
+    // Don't lose the best move of a position if we don't have one to replace it with
+    uint16_t m = pack_move(move);
+    if (m == 0 && same_key)
+        m = data_move(old_d);
+
+    const uint64_t d = pack_data(m, value, depth, bound, generation);
+    e.data.store(d, std::memory_order_relaxed);
+    e.key_xor_data.store(key ^ d, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+    const size_t n = std::min<size_t>(1000, n_entries);
+    int cnt = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t d = table[i].data.load(std::memory_order_relaxed);
+        cnt += data_bound(d) != Bound::None && data_generation(d) == generation;
+    }
+    return static_cast<int>(cnt * 1000 / n);
+}
@@ -0,0 +1,89 @@
+#ifndef __TT_H_
+#define __TT_H_
+
+#include "types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+enum class Bound : uint8_t {
+    None,
+    Upper,
+    Lower,
+    Exact
+};
+
+/**
+ * Unpacked content of a transposition table entry.
+ *
+ * NOTE: depth is the remaining search depth when the entry
+ * was stored, with 0 meaning a quiescence search result.
+ */
+struct TTData {
+    Move move;
+    int value;
+    int depth;
+    Bound bound;
+};
+
+/**
+ * Transposition table shared by all search threads.
+ *
+ * It is lock-free: each entry is stored as two 64 bits words, the packed data
+ * and the key xored with the data. A probe only accepts an entry if the two words
+ * it reads still xor back to the key, so an entry torn by concurrent writes
+ * is seen as a miss instead of returning garbage.
+ */
+class TranspositionTable {
+
+    struct Entry {
+        std::atomic<uint64_t> key_xor_data;
+        std::atomic<uint64_t> data;
+    };
+
+public:
+    explicit TranspositionTable(size_t mb_size);
+
+    void resize(size_t mb_size);
+    void clear();
+
+    /** To be called before each new search so that older entries get replaced first */
+    void new_search();
+
+    /** Fill `data' and return true if `key' is in the table */
+    bool probe(Key key, TTData& data) const;
+    void store(Key key, int value, Bound bound, int depth, const Move& move);
+
+    /** Permill of the first thousand entries used during the current search */
+    int hashfull() const;
+
+private:
+    std::unique_ptr<Entry[]> table;
+    size_t n_entries;
+    size_t mask;
+    uint8_t generation;
+
+    Entry& entry(Key key);
+    const Entry& entry(Key key) const;
+};
+
+extern TranspositionTable TT;
+
+/**
+ * Win scores are stored relative to the node instead of the root
+ * so that they stay valid when the entry is reached at another ply.
+ */
+constexpr int value_to_tt(int value, int ply) {
+    return value >= value_win_in_max_ply ? value + ply
+        : value <= -value_win_in_max_ply ? value - ply
+        : value;
+}
+constexpr int value_from_tt(int value, int ply) {
+    return value >= value_win_in_max_ply ? value - ply
+        : value <= -value_win_in_max_ply ? value + ply
+        : value;
+}
+
+#endif
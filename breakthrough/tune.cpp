@@ -0,0 +1,383 @@
+#include "types.h"
+#include "agent.h"
+#include "breakthrough.h"
+#include "eval.h"
+#include "eval_params.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Texel-style tuner for the evaluation parameters
+ *
+ * Usage: tune [n_games] [depth] [epochs] [threads] [output]
+ *
+ * 1. Self-play `n_games' games at depth `depth' (after a few random moves for
+ *    variety) and label every quiet position with the result of its game.
+ * 2. Fit the scaling constant K of the sigmoid mapping evaluations to
+ *    winning probabilities with the current parameters.
+ * 3. Minimise the mean squared error between those probabilities and the
+ *    results by gradient descent (Adam) over all the parameters of
+ *    eval_params.h, the gradient being computed in parallel.
+ * 4. Write the rounded parameters to `output' (eval_params.h by default).
+ *
+ * NOTE: The evaluation is linear in its parameters (see Eval::coefficients()),
+ * so each position is stored as its sparse coefficients and its material
+ * imbalance, which is the anchor that isn't tuned.
+ */
+namespace {
+
+    int n_games = 50000;
+    int s_depth = 2;
+    int n_epochs = 2000;
+    int n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    /** Number of random moves at the start of each game */
+    constexpr int random_plies = 6;
+
+    constexpr double learning_rate = 0.5;
+
+    /**
+     * Weight of the L2 penalty pulling the parameters towards their current
+     * values, so that the ones the positions say little about don't drift.
+     */
+    constexpr double regularization = 1e-8;
+
+    /**
+     * Labeled positions, each position i having its coefficients in
+     * [offsets[i], offsets[i + 1]) of `index' and `coeff'
+     */
+    struct Dataset {
+        std::vector<uint32_t> offsets { 0 };
+        std::vector<uint8_t> index;
+        std::vector<int8_t> coeff;
+        std::vector<int16_t> material;
+        std::vector<float> result;
+
+        size_t size() const { return result.size(); }
+
+        void append(const Dataset& other) {
+            const uint32_t base = offsets.back();
+            for (auto it = other.offsets.begin() + 1; it != other.offsets.end(); ++it)
+                offsets.push_back(base + *it);
+            index.insert(index.end(), other.index.begin(), other.index.end());
+            coeff.insert(coeff.end(), other.coeff.begin(), other.coeff.end());
+            material.insert(material.end(), other.material.begin(), other.material.end());
+            result.insert(result.end(), other.result.begin(), other.result.end());
+        }
+    };
+
+    std::vector<double> current_params() {
+        using namespace Eval;
+        std::vector<double> ret(Param::Count);
+
+        for (int row = 0; row < height; ++row)
+            for (int col = 0; col < width; ++col)
+                ret[Param::PawnSquare + col + row * width] = Bonus::pawn_square[row][col];
+        for (int row = 0; row < height; ++row) {
+            ret[Param::Lever + row] = Bonus::Lever[row];
+            ret[Param::Phalanx + row] = Bonus::Phalanx[row];
+            ret[Param::Passed + row] = Bonus::Passed[row];
+        }
+        ret[Param::Support] = Bonus::Support;
+
+        return ret;
+    }
+
+    /**
+     * Positions with a pawn about to promote are left out since they are
+     * decided, and so are positions where the side to move can capture
+     * a pawn that isn't defended.
+     *
+     * NOTE: Captures are available in most positions, so filtering all of
+     * them out would only leave positions from the opening.
+     */
+    template<Player P>
+    bool is_quiet(const Game& game) {
+        const Bitboard ours = game.pieces(P);
+        const Bitboard theirs = game.pieces(!P);
+
+        if ((ours & rank_bb(relative_row(P, 6))) || (theirs & rank_bb(relative_row(P, 1))))
+            return false;
+
+        return !(pawn_attacks<P>(ours) & theirs & ~pawn_attacks<!P>(theirs));
+    }
+
+    bool is_quiet(const Game& game) {
+        return game.player_to_move() == Player::White
+            ? is_quiet<Player::White>(game)
+            : is_quiet<Player::Black>(game);
+    }
+
+    void play_games(int n, unsigned seed, Dataset& data) {
+        std::mt19937 rng { seed };
+        const std::atomic<bool> never_stop { false };
+
+        for (int i = 0; i < n; ++i) {
+            Game game;
+            Agent agent { game };
+            agent.set_helper(&never_stop);
+
+            StateInfo states[max_depth];
+            StateInfo* st { &states[0] };
+            Dataset positions;
+
+            for (int ply = 0; !game.is_won(); ++ply) {
+                game.compute_valid_moves();
+                Move move;
+
+                if (ply < random_plies) {
+                    auto [beg, end] = game.valid_moves();
+                    std::uniform_int_distribution<int> dist(0, std::distance(beg, end) - 1);
+                    move = *(beg + dist(rng));
+                }
+                else {
+                    move = agent.iterative_deepening(0, s_depth);
+                }
+
+                game.apply(move, *st++);
+
+                if (ply < random_plies || game.is_won() || !is_quiet(game))
+                    continue;
+
+                auto coeffs = Eval::coefficients(game);
+                for (int j = 0; j < Eval::Param::Count; ++j) {
+                    if (coeffs[j] != 0) {
+                        positions.index.push_back(j);
+                        positions.coeff.push_back(coeffs[j]);
+                    }
+                }
+                positions.offsets.push_back(positions.index.size());
+                positions.material.push_back(game.material_imbalance());
+                positions.result.push_back(0);
+            }
+
+            // The last player to move won the game
+            const float white_result = game.player_to_move() == Player::Black ? 1.0f : 0.0f;
+            std::fill(positions.result.begin(), positions.result.end(), white_result);
+
+            data.append(positions);
+        }
+    }
+
+    double sigmoid(double k, double score) {
+        return 1.0 / (1.0 + std::exp(-k * score));
+    }
+
+    double evaluate(const Dataset& data, size_t i, const std::vector<double>& params) {
+        double score = data.material[i];
+        for (uint32_t j = data.offsets[i]; j < data.offsets[i + 1]; ++j)
+            score += data.coeff[j] * params[data.index[j]];
+        return score;
+    }
+
+    /**
+     * Mean squared error over the dataset, along with its gradient
+     * if `grad' isn't null, computed in parallel over chunks of positions.
+     */
+    double error(const Dataset& data, const std::vector<double>& params,
+                 double k, std::vector<double>* grad) {
+        const size_t n = data.size();
+        const size_t chunk = (n + n_threads - 1) / n_threads;
+
+        std::vector<double> errors(n_threads, 0.0);
+        std::vector<std::vector<double>> grads(n_threads, std::vector<double>(params.size(), 0.0));
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&, t] {
+                const size_t end = std::min(n, (t + 1) * chunk);
+                for (size_t i = t * chunk; i < end; ++i) {
+                    double s = sigmoid(k, evaluate(data, i, params));
+                    double diff = s - data.result[i];
+                    errors[t] += diff * diff;
+
+                    if (!grad)
+                        continue;
+                    double g = 2 * diff * s * (1 - s) * k;
+                    for (uint32_t j = data.offsets[i]; j < data.offsets[i + 1]; ++j)
+                        grads[t][data.index[j]] += g * data.coeff[j];
+                }
+            });
+        }
+        for (auto& th : threads)
+            th.join();
+
+        double ret = 0;
+        for (int t = 0; t < n_threads; ++t)
+            ret += errors[t];
+
+        if (grad) {
+            grad->assign(params.size(), 0.0);
+            for (int t = 0; t < n_threads; ++t)
+                for (size_t j = 0; j < params.size(); ++j)
+                    (*grad)[j] += grads[t][j] / n;
+        }
+        return ret / n;
+    }
+
+    /** Ternary search of the scaling constant minimizing the error */
+    double fit_k(const Dataset& data, const std::vector<double>& params) {
+        double lo = 1e-4, hi = 0.1;
+        for (int i = 0; i < 50; ++i) {
+            double m1 = lo + (hi - lo) / 3;
+            double m2 = hi - (hi - lo) / 3;
+            if (error(data, params, m1, nullptr) < error(data, params, m2, nullptr))
+                hi = m2;
+            else
+                lo = m1;
+        }
+        return (lo + hi) / 2;
+    }
+
+    void write_array(std::ostream& out, const std::vector<double>& params, int first) {
+        out << "{ ";
+        for (int row = 0; row < height; ++row)
+            out << (row ? ", " : "") << std::lround(params[first + row]);
+        out << " }";
+    }
+
+    void write_header(std::ostream& out, const std::vector<double>& params, const std::string& info) {
+        using namespace Eval;
+
+        out << "#ifndef __EVAL_PARAMS_H_\n"
+            << "#define __EVAL_PARAMS_H_\n\n"
+            << "#include \"types.h\"\n\n"
+            << "// " << info << "\n\n"
+            << "namespace Eval::Bonus {\n\n"
+            << "    /**\n"
+            << "     * Pawn-square table giving a base value to pawns on the grid\n"
+            << "     *\n"
+            << "     * NOTE: call pawn_square[row][col] with the row relative to the pawn's owner\n"
+            << "     */\n"
+            << "    constexpr int pawn_square[height][width] = {\n";
+        for (int row = 0; row < height; ++row) {
+            out << "        {";
+            for (int col = 0; col < width; ++col)
+                out << (col ? "," : "") << std::setw(4) << std::lround(params[Param::PawnSquare + col + row * width]);
+            out << " },\n";
+        }
+        out << "    };\n\n"
+            << "    /** Bonus points for a lever by rank */\n"
+            << "    constexpr int Lever[height] ";
+        write_array(out, params, Param::Lever);
+        out << ";\n\n"
+            << "    /** Bonus points per supporting pawn */\n"
+            << "    constexpr int Support { " << std::lround(params[Param::Support]) << " };\n\n"
+            << "    /** Bonus points for having two pawns side by side by rank */\n"
+            << "    constexpr int Phalanx[height] ";
+        write_array(out, params, Param::Phalanx);
+        out << ";\n\n"
+            << "    /** Bonus points for a passed pawn by rank */\n"
+            << "    constexpr int Passed[height] ";
+        write_array(out, params, Param::Passed);
+        out << ";\n\n"
+            << "} // namespace Eval::Bonus\n\n"
+            << "#endif\n";
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        n_games = std::stoi(argv[1]);
+    if (argc > 2)
+        s_depth = std::stoi(argv[2]);
+    if (argc > 3)
+        n_epochs = std::stoi(argv[3]);
+    if (argc > 4 && std::stoi(argv[4]) > 0)
+        n_threads = std::stoi(argv[4]);
+    std::string output = argc > 5 ? argv[5] : "eval_params.h";
+
+    // 1. Self-play
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Dataset> datasets(n_threads);
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < n_threads; ++t) {
+            int n = n_games / n_threads + (t < n_games % n_threads);
+            threads.emplace_back(play_games, n, 1000u + t, std::ref(datasets[t]));
+        }
+        for (auto& th : threads)
+            th.join();
+    }
+    Dataset data;
+    for (const auto& d : datasets)
+        data.append(d);
+    datasets.clear();
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "Generated " << data.size() << " positions from "
+              << n_games << " games in " << secs << "s" << std::endl;
+
+    if (data.size() == 0)
+        return EXIT_FAILURE;
+
+    // 2. Scaling constant
+    std::vector<double> params = current_params();
+    const double k = fit_k(data, params);
+    const double initial_error = error(data, params, k, nullptr);
+
+    std::cerr << "K = " << k << ", initial error " << initial_error << std::endl;
+
+    // 3. Adam
+    constexpr double beta1 = 0.9;
+    constexpr double beta2 = 0.999;
+    constexpr double eps = 1e-8;
+
+    std::vector<double> grad;
+    std::vector<double> m(params.size(), 0.0);
+    std::vector<double> v(params.size(), 0.0);
+    double err = initial_error;
+
+    const std::vector<double> initial_params = params;
+
+    for (int epoch = 1; epoch <= n_epochs; ++epoch) {
+        err = error(data, params, k, &grad);
+
+        for (size_t j = 0; j < params.size(); ++j)
+            grad[j] += 2 * regularization * (params[j] - initial_params[j]);
+
+        for (size_t j = 0; j < params.size(); ++j) {
+            m[j] = beta1 * m[j] + (1 - beta1) * grad[j];
+            v[j] = beta2 * v[j] + (1 - beta2) * grad[j] * grad[j];
+            double m_hat = m[j] / (1 - std::pow(beta1, epoch));
+            double v_hat = v[j] / (1 - std::pow(beta2, epoch));
+            params[j] -= learning_rate * m_hat / (std::sqrt(v_hat) + eps);
+        }
+
+        if (epoch % 100 == 0)
+            std::cerr << "epoch " << epoch << " error " << err << std::endl;
+    }
+
+    // 4. Output
+    std::ostringstream info;
+    info << "Generated by tune: " << data.size() << " positions from "
+         << n_games << " games at depth " << s_depth
+         << ", error " << initial_error << " -> " << err;
+
+    std::ofstream ofs { output };
+    if (!ofs) {
+        std::cerr << "failed to open output file "
+            << output << std::endl;
+        return EXIT_FAILURE;
+    }
+    write_header(ofs, params, info.str());
+
+    std::cerr << "Wrote " << output << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -1,7 +1,12 @@
 #ifndef __TYPES_H_
 #define __TYPES_H_
 
+#include <bit>
 #include <cassert>
+#include <cstdint>
+
+using Key = uint64_t;
+using Bitboard = uint64_t;
 
 constexpr int width = 8;
 constexpr int height = 8;
@@ -9,6 +14,10 @@ constexpr int Nsquares = 64;
 constexpr int max_n_moves = 48;
 constexpr int max_depth = 256;
 
+constexpr int pawn_value = 100;
+constexpr int value_win = 32000;
+constexpr int value_win_in_max_ply = value_win - max_depth;
+
 enum class Player {
     White,
     Black
@@ -77,6 +86,86 @@ constexpr Square square_at(int x, int y) {
 constexpr Move move_fromto(const Square& from, const Square& to) {
     return { from, to };
 }
+/**
+ * Pack a move into 16 bits (6 bits per square) for storage in the
+ * transposition table. Move_None packs to 0 since a1a1 is not a move.
+ */
+constexpr uint16_t pack_move(const Move& m) {
+    return m == Move_None ? 0
+        : (m.from.col + m.from.row * width) | ((m.to.col + m.to.row * width) << 6);
+}
+constexpr Move unpack_move(uint16_t m) {
+    return m == 0 ? Move_None
+        : Move{ Square{ m & 7, (m >> 3) & 7 }, Square{ (m >> 6) & 7, (m >> 9) & 7 } };
+}
+
+/**
+ * Bitboards have bit (col + 8 * row) set for a pawn on that square.
+ */
+constexpr Bitboard FileA = 0x0101010101010101ULL;
+constexpr Bitboard FileH = FileA << 7;
+constexpr Bitboard Rank1 = 0xFFULL;
 
+constexpr Bitboard square_bb(const Square& s) {
+    return 1ULL << (s.col + s.row * width);
+}
+constexpr Bitboard rank_bb(int row) {
+    return Rank1 << (8 * row);
+}
+constexpr Square square_of(int idx) {
+    return { idx & 7, idx >> 3 };
+}
+constexpr int popcount(Bitboard b) {
+    return std::popcount(b);
+}
+/** Index of the least significant bit, to be called on a non-empty bitboard */
+constexpr int lsb(Bitboard b) {
+    assert(b);
+    return std::countr_zero(b);
+}
+constexpr int pop_lsb(Bitboard& b) {
+    int idx = lsb(b);
+    b &= b - 1;
+    return idx;
+}
+/** Shift one row towards the last rank of P */
+template<Player P>
+constexpr Bitboard shift_forward(Bitboard b) {
+    return P == Player::White ? b << 8 : b >> 8;
+}
+constexpr Bitboard shift_east(Bitboard b) {
+    return (b << 1) & ~FileA;
+}
+constexpr Bitboard shift_west(Bitboard b) {
+    return (b >> 1) & ~FileH;
+}
+/** Squares diagonally in front of the pawns of P */
+template<Player P>
+constexpr Bitboard pawn_attacks(Bitboard b) {
+    return shift_east(shift_forward<P>(b)) | shift_west(shift_forward<P>(b));
+}
+/** All squares strictly in front of the pawns of P on their file */
+template<Player P>
+constexpr Bitboard front_fill(Bitboard b) {
+    b = shift_forward<P>(b);
+    if constexpr (P == Player::White) {
+        b |= b << 8;
+        b |= b << 16;
+        b |= b << 32;
+    }
+    else {
+        b |= b >> 8;
+        b |= b >> 16;
+        b |= b >> 32;
+    }
+    return b;
+}
+/** Pawns of P with no opponent's pawn in front of them on their file or the adjacent ones */
+template<Player P>
+constexpr Bitboard passed_pawns(Bitboard ours, Bitboard theirs) {
+    Bitboard span = front_fill<!P>(theirs);
+    span |= shift_east(span) | shift_west(span);
+    return ours & ~span;
+}
 
 #endif
@@ -43,7 +43,7 @@ struct Action {
 };
 
 template <Action::Type T, typename... Args>
-inline Action make_action(Args &&...args);
+inline Action make_action(const Args &...args);
 
 template <> inline Action make_action<Action::Type::Wait>() {
   Action action{Action::Type::Wait};
@@ -61,12 +61,12 @@ inline Action make_action<Action::Type::Move>(const int &s, const int &t,
 
 template <>
 inline Action make_action<Action::Type::Bomb>(const int &s, const int &t) {
-  Action action{Action::Type::Move};
+  Action action{Action::Type::Bomb};
   action.data.bomb = SendBomb{s, t};
   return action;
 }
 template <> inline Action make_action<Action::Type::Prod>(const int &t) {
-  Action action{Action::Type::Wait};
+  Action action{Action::Type::Prod};
   action.data.prod = IncreaseProd{t};
   return action;
 }
@@ -53,9 +53,17 @@ void Game::reset() {
   });
 }
 
+int Game::bombs_left(Owner owner) const {
+  return N_BOMBS - (owner == Owner::Me ? n_bombs_mine : n_bombs_theirs);
+}
+
 void Game::turn_update(std::istream &is) {
   using std::string;
   reset();
+  m_troops.clear();
+  // The bombs which are not seen this turn have exploded
+  std::vector<Bomb> bombs;
+  bombs.swap(m_bombs);
   int entityCount; // the number of entities (e.g. factories and troops)
   is >> entityCount;
   is.ignore();
@@ -78,6 +86,7 @@ void Game::turn_update(std::istream &is) {
                                : Owner::Me;
       node.n_troops = arg2;
       node.production = arg3;
+      node.turns_disabled = arg4;
       break;
     }
     case 'T': {
@@ -85,18 +94,28 @@ void Game::turn_update(std::istream &is) {
       edge.troops_owner = arg1 == -1 ? Owner::Them : Owner::Me;
       edge.n_troops = arg4;
       edge.turns_until_arrival = arg5;
+      m_troops.push_back(
+          Troop{edge.troops_owner, arg2, arg3, arg4, arg5});
       break;
     }
     case 'B': {
       auto it = std::find_if(
-          m_bombs.begin(), m_bombs.end(),
+          bombs.begin(), bombs.end(),
           [entityId](const auto &bomb) { return bomb.id == entityId; });
-      // Update new bombs only
-      if (it == m_bombs.end()) {
+      if (it != bombs.end()) {
+        Bomb &bomb = m_bombs.emplace_back(std::move(*it));
+        if (bomb.owner == Owner::Me) {
+          bomb.turns_until_explode = arg4;
+        }
+      } else {
         Bomb &bomb = m_bombs.emplace_back();
         bomb.id = entityId;
         bomb.owner = arg1 == -1 ? Owner::Them : Owner::Me;
         bomb.source = arg2;
+        ++(bomb.owner == Owner::Me ? n_bombs_mine : n_bombs_theirs);
+        if (bomb.owner == Owner::Me) {
+          bomb.turns_until_explode = arg4;
+        }
         if (arg3 != -1) {
           bomb.maybe_targets.push_back(arg3);
         } else {
@@ -12,10 +12,13 @@
 namespace cyborg {
 
 constexpr const int INT_INFTY = 32000;
+constexpr const int N_BOMBS = 2;
 
 struct Node;
 struct Edge;
+struct Troop;
 struct Bomb;
+enum class Owner;
 
 class Game {
 public:
@@ -35,12 +38,22 @@ public:
   /** Accessors */
   const std::vector<Node> &nodes() const { return m_nodes; }
   const std::vector<std::vector<Edge>> &edges() const { return m_edges; }
+  const std::vector<Troop> &troops() const { return m_troops; }
+  const std::vector<Bomb> &bombs() const { return m_bombs; }
   int turn() const { return n_turns; }
 
+  /**
+   * Number of bombs the owner can still send.
+   */
+  int bombs_left(Owner owner) const;
+
 private:
   std::vector<Node> m_nodes;
   std::vector<std::vector<Edge>> m_edges;
+  std::vector<Troop> m_troops;
   std::vector<Bomb> m_bombs;
+  int n_bombs_mine{0};
+  int n_bombs_theirs{0};
   int n_turns{0};
 
   /**
@@ -56,6 +69,7 @@ struct Node {
   Owner owner{Owner::None};
   int n_troops{0};
   int production{0};
+  int turns_disabled{0};
 };
 
 struct Edge {
@@ -65,6 +79,14 @@ struct Edge {
   int turns_until_arrival{INT_INFTY};
 };
 
+struct Troop {
+  Owner owner{Owner::None};
+  int source{-1};
+  int target{-1};
+  int n_troops{0};
+  int turns_until_arrival{INT_INFTY};
+};
+
 struct Bomb {
   int id{-1};
   Owner owner{Owner::None};
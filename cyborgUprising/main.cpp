@@ -2,6 +2,7 @@
 #include "search.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iterator>
 #include <string>
@@ -24,12 +25,14 @@ int main() {
 
   Game game;
   game.init(cin);
+  search::init(game);
 
   // game loop
   while (1) {
     game.turn_update(cin);
 
-    const std::vector<Action>& actions = search::attack_greedy(game);
+    const std::vector<Action>& actions =
+        search::search(game, std::chrono::milliseconds{40});
     cout << actions << endl;
   }
 }
@@ -1,9 +1,11 @@
 #include "search.h"
+#include "simulator.h"
 
 #include <algorithm>
 #include <array>
 #include <iostream>
 #include <numeric>
+#include <optional>
 #include <stdexcept>
 
 namespace cyborg::search {
@@ -29,24 +31,136 @@ struct Movement {
 std::vector<Movement> TroopsNeeded;
 constexpr const Movement movementNull = Movement{};
 
-std::array<int, MAX_MOVE_LEN> incoming(const Game &game, const Node &node) {
-  std::array<int, MAX_MOVE_LEN> ret{0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  for (size_t i = 0; i < game.nodes().size(); ++i) {
-    const Edge &edge = game.edges()[i][node.id];
-    if (edge.turns_until_arrival < INT_INFTY) {
-      ret[edge.turns_until_arrival] +=
-          (edge.troops_owner == Owner::Me ? 1 : -1) * edge.n_troops;
+constexpr int HORIZON = 20;
+/** Value of a unit of production past the horizon, in troops */
+constexpr int PRODUCTION_VALUE = 10;
+
+std::optional<sim::Simulator> simulator;
+
+/**
+ * Our advantage after the horizon, the opponent waiting.
+ */
+int evaluate(sim::State state) {
+  while (state.turn < HORIZON) {
+    simulator->step(state);
+  }
+  return simulator->n_troops(state, Owner::Me) -
+         simulator->n_troops(state, Owner::Them) +
+         PRODUCTION_VALUE * (simulator->production(state, Owner::Me) -
+                             simulator->production(state, Owner::Them));
+}
+
+/**
+ * The orders worth trying after those already given in `state': the
+ * troops just needed to take each factory, INC, and a bomb on each of
+ * the opponent's productive factories.
+ */
+void candidates(const sim::State &state, std::vector<Action> &out) {
+  out.clear();
+  const int n = simulator->n_factories();
+  for (int source = 0; source < n; ++source) {
+    const sim::Factory &factory = state.factories[source];
+    if (factory.owner != Owner::Me) {
+      continue;
+    }
+    if (factory.n_troops >= sim::INC_COST &&
+        factory.production < sim::MAX_PRODUCTION) {
+      out.push_back(make_action<Action::Type::Prod>(source));
+    }
+    for (int target = 0; target < n; ++target) {
+      const int d = simulator->distance(source, target);
+      if (d == INT_INFTY) {
+        continue;
+      }
+      const sim::Factory there =
+          simulator->forecast(state, target, state.turn + 1 + d);
+      const int needed = there.n_troops + 1;
+      if (there.owner != Owner::Me && needed <= factory.n_troops) {
+        out.push_back(make_action<Action::Type::Move>(source, target, needed));
+      }
+    }
+  }
+
+  if (state.bombs_left[0] == 0) {
+    return;
+  }
+  for (int target = 0; target < n; ++target) {
+    if (state.factories[target].owner != Owner::Them ||
+        state.factories[target].production < 2 ||
+        std::any_of(state.blasts.begin(), state.blasts.end(),
+                    [target](const auto &b) { return b.target == target; })) {
+      continue;
+    }
+    int source = -1;
+    for (int f = 0; f < n; ++f) {
+      if (state.factories[f].owner == Owner::Me &&
+          (source == -1 || simulator->distance(f, target) <
+                               simulator->distance(source, target))) {
+        source = f;
+      }
+    }
+    if (source != -1) {
+      out.push_back(make_action<Action::Type::Bomb>(source, target));
     }
   }
-  return ret;
 }
 
 } // namespace
 
-void init(const Game &game) { nodes_eval.resize(game.nodes().size()); }
+void init(const Game &game) {
+  nodes_eval.resize(game.nodes().size());
+  simulator.emplace(game, HORIZON);
+}
+
+const std::vector<Action> &search(const Game &game,
+                                  std::chrono::milliseconds budget) {
+  using Clock = std::chrono::steady_clock;
+  const auto deadline = Clock::now() + budget;
 
-Action search(const Game &game) { return make_action<Action::Type::Wait>(); }
+  static std::vector<Action> ret;
+  static std::vector<Action> moves;
+  ret.clear();
+  ret.push_back(make_action<Action::Type::Wait>());
+
+  sim::State planned = simulator->initial_state(game);
+  int value = evaluate(planned);
+  int n_evaluated = 1;
+
+  bool improved = true;
+  while (improved && Clock::now() < deadline) {
+    improved = false;
+    candidates(planned, moves);
+
+    sim::State best;
+    const Action *best_move = nullptr;
+    for (const auto &move : moves) {
+      if (Clock::now() >= deadline) {
+        break;
+      }
+      sim::State state = planned;
+      if (!simulator->order(state, Owner::Me, move)) {
+        continue;
+      }
+      const int v = evaluate(state);
+      ++n_evaluated;
+      if (v > value) {
+        value = v;
+        best = std::move(state);
+        best_move = &move;
+      }
+    }
+
+    if (best_move != nullptr) {
+      ret.push_back(*best_move);
+      planned = std::move(best);
+      improved = true;
+    }
+  }
+
+  std::cerr << "Search: " << ret.size() - 1 << " orders, " << n_evaluated
+            << " evaluations, value " << value << std::endl;
+  return ret;
+}
 
 const std::vector<Action> &attack_greedy(const Game &game) {
   static std::vector<Action> ret;
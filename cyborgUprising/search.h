@@ -3,13 +3,22 @@
 
 #include "game.h"
 
+#include <chrono>
 #include <deque>
 
 namespace cyborg::search {
 
 void init(const Game& game);
 
-Action search(const Game& game);
+/**
+ * Orders chosen by their simulated outcome, `HORIZON' turns ahead.
+ *
+ * Starting from WAIT, the candidate MOVE, BOMB or INC order which most
+ * improves the outcome is added to the set of orders, until none does or
+ * the `budget' is spent. The opponent is assumed not to send anything more.
+ */
+const std::vector<Action>& search(const Game& game,
+                                  std::chrono::milliseconds budget);
 
 /**
  * Attack from our biggest node
@@ -0,0 +1,172 @@
+#include "simulator.h"
+
+#include <algorithm>
+
+namespace cyborg::sim {
+
+Simulator::Simulator(const Game &game, int horizon)
+    : m_n_factories{static_cast<int>(game.nodes().size())},
+      m_horizon{horizon} {
+  m_distances.reserve(m_n_factories * m_n_factories);
+  for (const auto &edges : game.edges()) {
+    std::transform(edges.begin(), edges.end(),
+                   std::back_inserter(m_distances),
+                   [](const Edge &edge) { return edge.distance; });
+  }
+}
+
+State Simulator::initial_state(const Game &game) const {
+  State state;
+  state.factories.reserve(m_n_factories);
+  for (const auto &node : game.nodes()) {
+    state.factories.push_back(
+        Factory{node.owner, node.n_troops, node.production,
+                node.turns_disabled});
+  }
+
+  state.arrivals.assign(n_arrival_turns() * m_n_factories, {0, 0});
+  for (const auto &troop : game.troops()) {
+    arrivals(state, troop.turns_until_arrival, troop.target, troop.owner) +=
+        troop.n_troops;
+  }
+
+  for (const auto &bomb : game.bombs()) {
+    if (bomb.owner == Owner::Me && bomb.maybe_targets.size() == 1) {
+      state.blasts.push_back(
+          Blast{bomb.maybe_targets.front(), bomb.turns_until_explode});
+    }
+  }
+  state.bombs_left = {game.bombs_left(Owner::Me),
+                      game.bombs_left(Owner::Them)};
+  return state;
+}
+
+bool Simulator::order(State &state, Owner player, const Action &action) const {
+  switch (action.type) {
+  case Action::Type::Wait:
+    return true;
+  case Action::Type::Move: {
+    const MoveTroops &move = action.data.move;
+    Factory &source = state.factories[move.source];
+    const int d = distance(move.source, move.target);
+    if (source.owner != player || d == INT_INFTY || move.n_troops <= 0) {
+      return false;
+    }
+    const int n = std::min(move.n_troops, source.n_troops);
+    source.n_troops -= n;
+    arrivals(state, state.turn + 1 + d, move.target, player) += n;
+    return n > 0;
+  }
+  case Action::Type::Bomb: {
+    const SendBomb &bomb = action.data.bomb;
+    int &bombs_left = state.bombs_left[player == Owner::Me ? 0 : 1];
+    const int d = distance(bomb.source, bomb.target);
+    if (state.factories[bomb.source].owner != player || d == INT_INFTY ||
+        bombs_left == 0) {
+      return false;
+    }
+    --bombs_left;
+    state.blasts.push_back(Blast{bomb.target, state.turn + 1 + d});
+    return true;
+  }
+  case Action::Type::Prod: {
+    Factory &factory = state.factories[action.data.prod.target];
+    if (factory.owner != player || factory.n_troops < INC_COST ||
+        factory.production == MAX_PRODUCTION) {
+      return false;
+    }
+    factory.n_troops -= INC_COST;
+    ++factory.production;
+    return true;
+  }
+  }
+  return false;
+}
+
+void Simulator::produce(Factory &factory) {
+  if (factory.turns_disabled > 0) {
+    --factory.turns_disabled;
+  } else if (factory.owner != Owner::None) {
+    factory.n_troops += factory.production;
+  }
+}
+
+void Simulator::battle(Factory &factory, std::array<int, 2> arriving) {
+  // The players' troops first fight each other
+  const int n_killed = std::min(arriving[0], arriving[1]);
+  arriving[0] -= n_killed;
+  arriving[1] -= n_killed;
+
+  const Owner attacker = arriving[0] > 0 ? Owner::Me : Owner::Them;
+  const int n_attackers = std::max(arriving[0], arriving[1]);
+  if (n_attackers == 0) {
+    return;
+  }
+  if (factory.owner == attacker) {
+    factory.n_troops += n_attackers;
+  } else if (n_attackers > factory.n_troops) {
+    factory.owner = attacker;
+    factory.n_troops = n_attackers - factory.n_troops;
+  } else {
+    factory.n_troops -= n_attackers;
+  }
+}
+
+void Simulator::explode(Factory &factory) {
+  factory.n_troops -= std::min(
+      factory.n_troops, std::max(BOMB_MIN_DAMAGE, factory.n_troops / 2));
+  factory.turns_disabled = BOMB_DISABLE_TURNS;
+}
+
+void Simulator::step(State &state) const {
+  ++state.turn;
+  for (int f = 0; f < m_n_factories; ++f) {
+    Factory &factory = state.factories[f];
+    produce(factory);
+    battle(factory, state.arrivals[state.turn * m_n_factories + f]);
+    state.arrivals[state.turn * m_n_factories + f] = {0, 0};
+  }
+  for (const auto &blast : state.blasts) {
+    if (blast.turn == state.turn) {
+      explode(state.factories[blast.target]);
+    }
+  }
+}
+
+int Simulator::n_troops(const State &state, Owner player) const {
+  const int p = player == Owner::Me ? 0 : 1;
+  int n = 0;
+  for (const auto &factory : state.factories) {
+    n += factory.owner == player ? factory.n_troops : 0;
+  }
+  for (size_t i = (state.turn + 1) * m_n_factories; i < state.arrivals.size();
+       ++i) {
+    n += state.arrivals[i][p];
+  }
+  return n;
+}
+
+int Simulator::production(const State &state, Owner player) const {
+  int n = 0;
+  for (const auto &factory : state.factories) {
+    n += factory.owner == player ? factory.production : 0;
+  }
+  return n;
+}
+
+Factory Simulator::forecast(const State &state, int factory, int turn) const {
+  Factory ret = state.factories[factory];
+  for (int t = state.turn + 1; t <= std::min(turn, n_arrival_turns() - 1);
+       ++t) {
+    produce(ret);
+    battle(ret, state.arrivals[t * m_n_factories + factory]);
+    for (const auto &blast : state.blasts) {
+      if (blast.turn == t && blast.target == factory) {
+        explode(ret);
+      }
+    }
+  }
+  return ret;
+}
+
+} // namespace cyborg::sim
@@ -0,0 +1,118 @@
+#ifndef SIMULATOR_H_
+#define SIMULATOR_H_
+
+#include "game.h"
+
+#include <array>
+#include <vector>
+
+namespace cyborg::sim {
+
+/** Longest link of a map */
+constexpr int MAX_DISTANCE = 20;
+constexpr int MAX_PRODUCTION = 3;
+constexpr int INC_COST = 10;
+constexpr int BOMB_MIN_DAMAGE = 10;
+constexpr int BOMB_DISABLE_TURNS = 5;
+
+struct Factory {
+  Owner owner{Owner::None};
+  int n_troops{0};
+  int production{0};
+  int turns_disabled{0};
+};
+
+struct Blast {
+  int target{-1};
+  int turn{INT_INFTY};
+};
+
+/**
+ * The factories and what is on its way to them, `turn' turns after the
+ * state of the Game it was built from.
+ *
+ * The troops are only kept as the number arriving at each factory on each
+ * turn, for each player. The opponent's bombs are left out: their targets
+ * are not known.
+ */
+struct State {
+  std::vector<Factory> factories;
+  /** Troops of each player (Me, Them) arriving at each factory, by turn */
+  std::vector<std::array<int, 2>> arrivals;
+  std::vector<Blast> blasts;
+  std::array<int, 2> bombs_left{0, 0};
+  int turn{0};
+};
+
+/**
+ * The rules of the game on the map of a Game: troops moving and fighting,
+ * production, INC and bombs.
+ *
+ * Each turn, the orders are given with order() before the call to step(),
+ * which then produces, resolves the battles and explodes the bombs.
+ */
+class Simulator {
+public:
+  /**
+   * Simulate at most `horizon' turns on the map of `game'.
+   */
+  Simulator(const Game &game, int horizon);
+
+  /**
+   * The current state of `game'.
+   */
+  State initial_state(const Game &game) const;
+
+  /**
+   * Execute the order of `player' if it is valid, return whether it is.
+   */
+  bool order(State &state, Owner player, const Action &action) const;
+
+  /**
+   * Advance the state to the next turn.
+   */
+  void step(State &state) const;
+
+  /**
+   * The troops of `player' in the factories and on their way.
+   */
+  int n_troops(const State &state, Owner player) const;
+
+  int production(const State &state, Owner player) const;
+
+  /**
+   * Owner and troops of the factory just after the battle of turn
+   * `turn', when no further order is given.
+   */
+  Factory forecast(const State &state, int factory, int turn) const;
+
+  int distance(int source, int target) const {
+    return m_distances[source * m_n_factories + target];
+  }
+  int n_factories() const { return m_n_factories; }
+  int horizon() const { return m_horizon; }
+
+private:
+  int m_n_factories;
+  int m_horizon;
+  std::vector<int> m_distances;
+
+  int &arrivals(State &state, int turn, int factory, Owner player) const {
+    return state.arrivals[turn * m_n_factories + factory]
+                         [player == Owner::Me ? 0 : 1];
+  }
+
+  /**
+   * Turns kept in State::arrivals: until the arrival of the troops sent
+   * on the last simulated turn.
+   */
+  int n_arrival_turns() const { return m_horizon + MAX_DISTANCE + 2; }
+
+  static void produce(Factory &factory);
+  static void battle(Factory &factory, std::array<int, 2> arriving);
+  static void explode(Factory &factory);
+};
+
+} // namespace cyborg::sim
+
+#endif // SIMULATOR_H_
@@ -2,13 +2,12 @@
 #include "dp.h"
 
 #include <algorithm>
-#include <array>
+#include <bitset>
 #include <cassert>
 #include <cmath>
 #include <deque>
 #include <iostream>
-#include <numeric>
-#include <string>
+#include <vector>
 
 namespace {
 
@@ -16,48 +15,78 @@ namespace {
 /// at which the elevator will be taken on a state's floor
 using AAction = int;
 
-/// Same for elevators, since we split them into floors
-using AElevator = int;
-
-constexpr int max_actions = dp::max_width;
-
 using Cost = int;
-constexpr int cost_max = dp::max_width * dp::max_height + 1;
+constexpr Cost cost_max = dp::max_turns + 1;
+
+/// A node of the search: the leading clone just arrived on `floor`
+/// at `pos`, walking towards `dir`, with `elevators` player elevators
+/// left and `clones` clones used so far.
+///
+/// The floor above the exit's stands for the exit itself.
+struct Node {
+    int floor;
+    int pos;
+    dp::Dir dir;
+    int elevators;
+    int clones;
+};
 
 /// Globals
-dp::State states[dp::max_turns + 1];
-dp::State* ps = &states[0];
 const dp::GameParams* gparams;
+Node root;
+
+/// Number of floors in the tables, the exit counting as one more floor
+int n_floors;
+
+/// Number of values for the elevators left
+int n_elevators;
+
+/// The most clones that can be used, one has to be left for reaching the exit
+int max_clones_used;
+
+/// The elevators, split into floors as bitmaps of their positions
+std::vector<std::bitset<dp::max_width>> elevator_bits;
 
-using ActionList = std::vector<AAction>;
+/// The closest elevator strictly on the left (or -1) and
+/// strictly on the right (or width) of each cell
+std::vector<std::vector<int>> elevator_left;
+std::vector<std::vector<int>> elevator_right;
 
-/// The elevators, split into floors
-std::vector<std::vector<AElevator>> elevators;
-std::vector<int> n_empty_floors_above;
+/// Fewest turns and fewest clones needed to reach the exit from each
+/// (floor, pos, dir, elevators) when the other resource is unlimited,
+/// both admissible bounds for the actual problem
+std::vector<Cost> turns_lb;
+std::vector<int> clones_lb;
 
-/// The actions to consider at each floor
-std::vector<ActionList> candidates;
+/// Best number of turns found to reach each node of the search,
+/// and the node it was reached from
+std::vector<Cost> g_cost;
+std::vector<int> parent;
 
-/// A buffer for populating the search tree
-ActionList actions_buffer;
+/// The nodes to expand, bucketed by their lower bound on the total cost
+std::vector<std::vector<int>> buckets;
 
-/// Another buffer to store cost computations
-std::vector<int> cost_buffer;
+/// Number of nodes expanded by the last search
+int n_expanded;
 
 /// Used to populate the elevators
 void init_elevators();
 
-/// Used to populate the candidates
-void init_actions();
+/// Compute the lower bounds by backward induction over the floors
+void init_bounds();
 
 /// Initialize the search
 void init(const dp::Game& g);
 
+/// A* over the nodes, returns the index of the exit node or -1
+int astar();
+
+/// Transform the path to `goal` into the actual dp::Actions
+void populate_actions(int goal);
+
 /// A queue for real Actions to be played
 std::deque<dp::Action> best_actions;
 
-bool depth_first_search(const dp::State& s, int max_depth);
-
 } // namespace
 
 namespace dp::agent {
@@ -72,15 +101,24 @@ dp::Action best_choice()
     return action;
 }
 
-void search(const Game& g)
+int explored_nodes()
 {
-    assert(ps == &states[1]);
+    return n_expanded;
+}
 
+void search(const Game& g)
+{
     init(g);
 
-    bool found = depth_first_search(states[0], gparams->exit_floor);
+    int goal = astar();
+
+    assert(goal != -1);
+    if (goal == -1) {
+        std::cerr << "No solution found" << std::endl;
+        return;
+    }
 
-    assert(found);
+    populate_actions(goal);
 
     // Have to wait once at exit
     best_actions.push_back(dp::Action::Wait);
@@ -91,138 +129,49 @@ void search(const Game& g)
 namespace {
 using namespace dp;
 
-/// Split the elevators into floors and order them wrt their position
+/// Split the elevators into floors and find the closest ones of each cell
 void init_elevators()
 {
-    for (int i = 0; i <= gparams->exit_floor; ++i) {
-        auto& elevs = elevators.emplace_back();
-        for (const auto& el : gparams->elevators) {
-            if (el.floor == i)
-                elevs.push_back(el.pos);
-        }
-        std::sort(elevs.begin(), elevs.end());
-    }
-}
-
-/// Only elevators under or one-off of an elevator
-/// above need to be considered
-void init_actions()
-{
-    std::vector<std::vector<bool>> seen;
-    for (int i = 0; i <= gparams->exit_floor; ++i) {
-        seen.push_back(std::vector<bool>(gparams->width, false));
-    }
-
-    n_empty_floors_above.push_back(std::count_if(elevators.begin(), elevators.begin() + gparams->exit_floor, [](const auto& els) {
-        return els.empty();
-    }));
-    for (int i = 0; i < gparams->exit_floor - 1; ++i) {
-        n_empty_floors_above.push_back(n_empty_floors_above[i] - elevators[i].empty());
-    }
-    n_empty_floors_above.push_back(0);
-    n_empty_floors_above.push_back(0);
-
-    const int max_gap = gparams->n_add_elevators;
-    auto elevator_gap = [max_gap](int floor) {
-        return max_gap - n_empty_floors_above[floor];
-    };
-
-    /// add a target at the exit itself
-    seen[gparams->exit_floor][gparams->exit_pos] = true;
+    elevator_bits.assign(n_floors, {});
+    elevator_left.assign(n_floors, std::vector<int>(gparams->width, -1));
+    elevator_right.assign(n_floors, std::vector<int>(gparams->width, gparams->width));
 
-    /// add targets under the exit
-    for (int f = gparams->exit_floor, p = gparams->exit_pos; f >= gparams->exit_floor - max_gap && f >= 0; --f) {
-        seen[f][p] = true;
+    for (const auto& el : gparams->elevators) {
+        if (el.floor < n_floors)
+            elevator_bits[el.floor].set(el.pos);
     }
 
-    /// add targets at the columns before any elevators blocking the exit
-    {
-        auto first_rightof_exit = std::find_if(elevators[gparams->exit_floor].begin(), elevators[gparams->exit_floor].end(), [p = gparams->exit_pos](const auto& el) {
-            return el > p;
-        });
-        auto first_leftof_exit = std::find_if(elevators[gparams->exit_floor].rbegin(), elevators[gparams->exit_floor].rend(), [p = gparams->exit_pos](const auto& el) {
-            return el < p;
-        });
-
-        if (first_rightof_exit != elevators[gparams->exit_floor].end()) {
-            for (int f = gparams->exit_floor - 1, p = *first_rightof_exit - 1; f >= gparams->exit_floor - 1 - max_gap && f >= 0; --f) {
-                seen[f][p] = true;
-            }
+    for (int f = 0; f < n_floors; ++f) {
+        for (int p = 1; p < gparams->width; ++p) {
+            elevator_left[f][p] = elevator_bits[f][p - 1] ? p - 1 : elevator_left[f][p - 1];
         }
-        if (first_leftof_exit != elevators[gparams->exit_floor].rend()) {
-            for (int f = gparams->exit_floor - 1, p = *first_leftof_exit + 1; f >= gparams->exit_floor - 1 - max_gap && f >= 0; --f) {
-                seen[f][p] = true;
-            }
-        }
-    }
-
-    /// add targets around elevator columns
-    for (int fl = gparams->exit_floor - 1; fl >= 0; --fl) {
-        for (AElevator el : elevators[fl]) {
-            /// Considers all three columns adjacent to the elevator
-            for (int p = el - 1; p < el + 2; ++p) {
-                /// Go downwards by the `allowed_gap` amount of floors, if column isn't bad
-                if (p < 0 || p > gparams->width - 1)
-                    continue;
-                for (int f = fl; f >= (fl - elevator_gap(fl)) && f >= 0; --f) {
-                    seen[f][p] = true;
-                }
-            }
+        for (int p = gparams->width - 2; p >= 0; --p) {
+            elevator_right[f][p] = elevator_bits[f][p + 1] ? p + 1 : elevator_right[f][p + 1];
         }
     }
-    /// Save the result in the global vector
-    for (int i = 0; i <= gparams->exit_floor; ++i)
-        std::transform(seen.begin(), seen.end(), std::back_inserter(candidates), [](const auto& target) {
-            ActionList ret;
-            for (int p = 0; p < gparams->width; ++p)
-                if (target[p])
-                    ret.push_back(p);
-            return ret;
-        });
-}
-
-void init(const dp::Game& g)
-{
-    std::fill(&states[0], &states[dp::max_turns], dp::State {});
-
-    gparams = g.get_params();
-    states[0] = *g.state();
-    ps = &states[1];
-
-    init_elevators();
-    init_actions();
-    cost_buffer.reserve(gparams->width);
-    std::fill_n(std::back_inserter(cost_buffer), gparams->width, cost_max);
-}
-
-inline bool at_exit_floor(const State& s)
-{
-    return s.floor == gparams->exit_floor;
 }
 
-inline bool at_exit(const State& s)
+inline bool at_exit_floor(int floor)
 {
-    return at_exit_floor(s) && s.pos == gparams->exit_pos;
+    return floor == gparams->exit_floor;
 }
 
 inline bool on_elevator(int pos, int floor)
 {
-    return std::find_if(gparams->elevators.begin(), gparams->elevators.end(), [p = pos, f = floor](const auto& el) {
-        return el.floor == f && el.pos == p;
-    }) != gparams->elevators.end();
+    return elevator_bits[floor][pos];
 }
 
-/// true if the action sequence ends with the player creating an elevator
-inline bool is_player_elevator(const State& s, const AAction a)
+/// true if the action ends with the player creating an elevator
+inline bool is_player_elevator(int floor, const AAction a)
 {
-    return !on_elevator(a, s.floor) && !at_exit_floor(s);
+    return !on_elevator(a, floor) && !at_exit_floor(floor);
 }
 
-/// True if the action sequence starts with a block
-inline bool is_block(const State& s, const AAction a)
+/// True if the action starts with a block
+inline bool is_block(int pos, Dir dir, const AAction a)
 {
-    return ((s.dir == Dir::Right) && (a < s.pos))
-        || ((s.dir == Dir::Left) && (a > s.pos));
+    return ((dir == Dir::Right) && (a < pos))
+        || ((dir == Dir::Left) && (a > pos));
 }
 
 inline Dir opposite(Dir d)
@@ -230,174 +179,213 @@ inline Dir opposite(Dir d)
     return d == Dir::Left ? Dir::Right : Dir::Left;
 }
 
-inline int distance(int fa, int pa, int fb, int pb)
+/// The positions reachable on the floor before an elevator takes the clone up
+inline std::pair<int, int> action_range(int floor, int pos, Dir dir)
 {
-    return std::abs(fb - fa) + std::abs(pb - pa);
+    int first_el_left = std::max(elevator_left[floor][pos], 0);
+    int first_el_right = std::min(elevator_right[floor][pos], gparams->width - 1);
+
+    if (on_elevator(pos, floor)) {
+        if (dir == Dir::Right)
+            first_el_right = pos;
+        else
+            first_el_left = pos;
+    }
+
+    if (at_exit_floor(floor)) {
+        if (gparams->exit_pos < first_el_left || gparams->exit_pos > first_el_right)
+            return { 1, 0 };
+        return { gparams->exit_pos, gparams->exit_pos };
+    }
+    return { first_el_left, first_el_right };
 }
 
-/// Number of turns taken to apply action a on state s.
-inline Cost action_cost(const State& s, const AAction a)
+/// Number of turns taken to apply action a
+inline Cost action_cost(int floor, int pos, Dir dir, const AAction a)
 {
-    const bool is_exit_floor = s.floor == gparams->exit_floor;
-    const int dist = distance(s.pos, s.floor, a, s.floor) + (1 - is_exit_floor);
-    return 3 * is_block(s, a) + dist + 3 * is_player_elevator(s, a);
+    return 3 * is_block(pos, dir, a)
+        + std::abs(a - pos)
+        + 3 * is_player_elevator(floor, a)
+        + (1 - at_exit_floor(floor));
 }
 
-inline Cost future_cost_lb(const State& s)
+/// Index in the tables of the lower bounds
+inline int bound_index(int floor, int pos, Dir dir, int elevators)
 {
-    return distance(s.floor, s.pos, gparams->exit_floor, gparams->exit_pos)
-        + (1 - (at_exit_floor(s)));
+    return ((floor * gparams->width + pos) * 2 + int(dir)) * n_elevators + elevators;
 }
 
-inline Cost future_cost_lb(const State& s, const AAction a)
+inline int node_index(const Node& n)
 {
-    return action_cost(s, a)
-        + distance(s.floor + (1 - at_exit_floor(s)), a, gparams->exit_floor, gparams->exit_pos);
+    return bound_index(n.floor, n.pos, n.dir, n.elevators) * (max_clones_used + 1) + n.clones;
 }
 
-/// True if the game is lost
-inline bool is_lost(const State& s)
+inline Node node_at(int index)
 {
-    return future_cost_lb(s) > s.turn
-        || n_empty_floors_above[s.floor] > s.player_elevators
-        || s.clones < 0;
-    //|| s.floor > gparams->exit_floor
-    //|| s.pos < 0 || s.pos > gparams->width - 1;
+    Node n;
+    n.clones = index % (max_clones_used + 1);
+    index /= max_clones_used + 1;
+    n.elevators = index % n_elevators;
+    index /= n_elevators;
+    n.dir = Dir(index % 2);
+    index /= 2;
+    n.pos = index % gparams->width;
+    n.floor = index / gparams->width;
+    return n;
 }
 
-State& apply(const State& s, const AAction a)
+/// Call `f' with each node following `n' and the turns it took
+template <typename F>
+inline void for_each_child(const Node& n, F&& f)
 {
-    const bool is_b = is_block(s, a);
-    const bool is_ef = s.floor == gparams->exit_floor;
-    const bool is_pe = is_player_elevator(s, a);
-
-    State& nex = *ps++;
-    nex.dir = is_b ? opposite(s.dir) : s.dir;
-    nex.pos = a;
-    nex.floor = s.floor + (1 - is_ef);
-    nex.turn = s.turn
-        - 3 * is_b
-        - distance(s.floor, s.pos, s.floor, a)
-        - 3 * is_pe
-        - (1 - is_ef);
-    nex.clones = s.clones - is_pe - is_b;
-    nex.player_elevators = s.player_elevators - is_pe;
-
-    nex.prev = const_cast<State*>(&s);
-    return nex;
+    auto [first, last] = action_range(n.floor, n.pos, n.dir);
+
+    for (AAction a = first; a <= last; ++a) {
+        const bool is_b = is_block(n.pos, n.dir, a);
+        const bool is_pe = is_player_elevator(n.floor, a);
+        if (is_pe && n.elevators == 0)
+            continue;
+
+        Node child;
+        child.floor = n.floor + 1;
+        child.pos = a;
+        child.dir = is_b ? opposite(n.dir) : n.dir;
+        child.elevators = n.elevators - is_pe;
+        child.clones = n.clones + is_b + is_pe;
+
+        f(child, action_cost(n.floor, n.pos, n.dir, a));
+    }
 }
 
-/// Transform an AAction into a sequence of actual dp::Actions once a solution is found
-void populate_actions(const State& s, const AAction a, std::deque<dp::Action>& q)
+void init_bounds()
 {
-    if (s.floor < gparams->exit_floor)
-        q.push_front(dp::Action::Wait);
-
-    if (is_player_elevator(s, a)) {
-        for (int i = 0; i < 2; ++i)
-            q.push_front(dp::Action::Wait);
-        q.push_front(dp::Action::Elevator);
+    const int size = n_floors * gparams->width * 2 * n_elevators;
+    turns_lb.assign(size, cost_max);
+    clones_lb.assign(size, cost_max);
+
+    // The exit
+    for (int e = 0; e < n_elevators; ++e) {
+        for (Dir d : { Dir::Right, Dir::Left }) {
+            turns_lb[bound_index(n_floors - 1, gparams->exit_pos, d, e)] = 0;
+            clones_lb[bound_index(n_floors - 1, gparams->exit_pos, d, e)] = 0;
+        }
     }
 
-    for (int i = 0; i < distance(s.floor, s.pos, s.floor, a); ++i)
-        q.push_front(dp::Action::Wait);
-
-    if (is_block(s, a)) {
-        for (int i = 0; i < 2; ++i)
-            q.push_front(dp::Action::Wait);
-        q.push_front(dp::Action::Block);
+    for (int f = n_floors - 2; f >= 0; --f) {
+        for (int p = 0; p < gparams->width; ++p) {
+            for (Dir d : { Dir::Right, Dir::Left }) {
+                for (int e = 0; e < n_elevators; ++e) {
+                    const int ndx = bound_index(f, p, d, e);
+                    for_each_child(Node { f, p, d, e, 0 }, [ndx](const Node& child, Cost cost) {
+                        const int cndx = bound_index(child.floor, child.pos, child.dir, child.elevators);
+                        turns_lb[ndx] = std::min(turns_lb[ndx], cost + turns_lb[cndx]);
+                        clones_lb[ndx] = std::min(clones_lb[ndx], child.clones + clones_lb[cndx]);
+                    });
+                }
+            }
+        }
     }
 }
 
-/// Draw from the candidates to get the reachable actions
-const std::vector<AAction>& get_valid_actions(const State& s)
+void init(const dp::Game& g)
 {
-    actions_buffer.clear();
-
-    int first_el_right = gparams->width - 1;
-    int first_el_left = 0;
-
-    bool ignore_right = false, ignore_left = false;
-
-    if (on_elevator(s.pos, s.floor)) {
-        if (s.dir == Dir::Right) {
-            first_el_right = s.pos;
-            ignore_right = true;
-        } else if (s.dir == Dir::Left) {
-            first_el_left = s.pos;
-            ignore_left = true;
-        }
-    }
+    gparams = g.get_params();
+    best_actions.clear();
 
-    if (!ignore_right) {
-        auto el_right = std::find_if(elevators[s.floor].begin(), elevators[s.floor].end(), [p = s.pos](AElevator el) {
-            return el > p;
-        });
+    const State& s = *g.state();
+    n_floors = gparams->exit_floor + 2;
+    n_elevators = gparams->n_add_elevators + 1;
+    max_clones_used = std::max(gparams->max_clones - 1, 0);
+    root = Node { s.floor, s.pos, s.dir, s.player_elevators, 0 };
 
-        if (el_right != elevators[s.floor].end()) {
-            first_el_right = *el_right;
-        }
-    }
+    init_elevators();
+    init_bounds();
+}
 
-    if (!ignore_left) {
-        auto el_left = std::find_if(elevators[s.floor].rbegin(), elevators[s.floor].rend(), [p = s.pos](AElevator el) {
-            return el < p;
-        });
+int astar()
+{
+    // The clone has to reach the exit before the last round
+    const int max_cost = gparams->max_round - 1;
 
-        if (el_left != elevators[s.floor].rend()) {
-            first_el_left = *el_left;
-        }
-    }
+    g_cost.assign(n_floors * gparams->width * 2 * n_elevators * (max_clones_used + 1), cost_max);
+    parent.assign(g_cost.size(), -1);
+    buckets.assign(max_cost + 1, {});
+    n_expanded = 0;
 
-    const auto& cands = candidates[s.floor];
-    std::fill(cost_buffer.begin(), cost_buffer.end(), cost_max);
+    auto h = [](const Node& n) {
+        return turns_lb[bound_index(n.floor, n.pos, n.dir, n.elevators)];
+    };
 
-    for (AAction a : candidates[s.floor]) {
-        if (a >= first_el_left
-            && a <= first_el_right) {
-            /// Skip action if not enough turns left
-            cost_buffer[a] = future_cost_lb(s, a);
-            if (cost_buffer[a] > s.turn)
+    const int root_ndx = node_index(root);
+    if (h(root) > max_cost)
+        return -1;
+    g_cost[root_ndx] = 0;
+    buckets[h(root)].push_back(root_ndx);
+
+    // The lower bounds being exact without the clones' limit, the costs
+    // are consistent and a node is final the first time it is expanded
+    for (int f_cost = 0; f_cost <= max_cost; ++f_cost) {
+        auto& bucket = buckets[f_cost];
+        while (!bucket.empty()) {
+            const int ndx = bucket.back();
+            bucket.pop_back();
+
+            const Node n = node_at(ndx);
+            if (g_cost[ndx] + h(n) != f_cost)
                 continue;
-            actions_buffer.push_back(a);
+            if (n.floor == n_floors - 1)
+                return ndx;
+
+            ++n_expanded;
+
+            for_each_child(n, [&](const Node& child, Cost cost) {
+                const int bndx = bound_index(child.floor, child.pos, child.dir, child.elevators);
+                if (child.clones + clones_lb[bndx] > max_clones_used)
+                    return;
+                const Cost g = g_cost[ndx] + cost;
+                const Cost fc = g + turns_lb[bndx];
+                const int cndx = node_index(child);
+                if (fc > max_cost || g >= g_cost[cndx])
+                    return;
+                g_cost[cndx] = g;
+                parent[cndx] = ndx;
+                buckets[fc].push_back(cndx);
+            });
         }
     }
 
-    std::sort(actions_buffer.begin(), actions_buffer.end(), [](AAction a, AAction b) {
-        return cost_buffer[a] < cost_buffer[b];
-    });
-
-    return actions_buffer;
+    return -1;
 }
 
-bool depth_first_search(const State& s, int max_depth)
+/// Push the actions leading from `s' to `next' in front of the queue
+void populate_actions(const Node& s, const Node& next, std::deque<dp::Action>& q)
 {
-    if (is_lost(s)) {
-        return false;
-    }
-    if (at_exit(s)) {
-        return true;
-    }
+    const AAction a = next.pos;
 
-    std::array<AAction, dp::max_width> actions;
-    actions.fill(-1);
-    const auto& valid_actions = get_valid_actions(s);
-    const int n_actions = valid_actions.size();
+    if (s.floor < gparams->exit_floor)
+        q.push_front(dp::Action::Wait);
 
-    std::copy(valid_actions.begin(), valid_actions.end(), actions.begin());
+    if (is_player_elevator(s.floor, a)) {
+        for (int i = 0; i < 2; ++i)
+            q.push_front(dp::Action::Wait);
+        q.push_front(dp::Action::Elevator);
+    }
 
-    for (auto a = actions.begin(); a != actions.begin() + n_actions; ++a) {
-        State& st = apply(s, *a);
-        bool found = depth_first_search(st, max_depth - 1);
-        --ps;
+    for (int i = 0; i < std::abs(a - s.pos); ++i)
+        q.push_front(dp::Action::Wait);
 
-        if (found) {
-            populate_actions(s, *a, best_actions);
-            return true;
-        }
+    if (is_block(s.pos, s.dir, a)) {
+        for (int i = 0; i < 2; ++i)
+            q.push_front(dp::Action::Wait);
+        q.push_front(dp::Action::Block);
     }
+}
 
-    return false;
+void populate_actions(int goal)
+{
+    for (int ndx = goal; parent[ndx] != -1; ndx = parent[ndx]) {
+        populate_actions(node_at(parent[ndx]), node_at(ndx), best_actions);
+    }
 }
 
 } // namespace
@@ -12,6 +12,9 @@ namespace agent {
     /// The best choice to date
     dp::Action best_choice();
 
+    /// Number of nodes expanded by the last search
+    int explored_nodes();
+
 } // namespace agent
 } // namespace dp
 
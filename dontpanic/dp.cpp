@@ -17,6 +17,8 @@ namespace {
 
 void Game::init(std::istream& _in)
 {
+    params = GameParams {};
+
     int n_elevators;
     _in >> params.height
         >> params.width
@@ -31,9 +31,11 @@ void DpMgr::load(const Game& game)
     width = prm->width + 2;
     height = prm->height;
 
-    m_grid.reserve(width * height);
-
-    std::fill_n(std::back_inserter(m_grid), width * height, cell_t::Empty);
+    m_grid.assign(width * height, cell_t::Empty);
+    m_blocked.assign(width * height, false);
+    m_clones.clear();
+    player_elevators.clear();
+    blocked_clones.clear();
 
     // add the walls
     for (int i = 0; i < prm->height; ++i) {
@@ -43,12 +45,12 @@ void DpMgr::load(const Game& game)
 
     // add the elevators
     for (const auto& el : prm->elevators) {
-        m_grid[el.floor * width + (el.pos + 1)] = cell_t::Elevator;
+        m_grid[cell_index(el.floor, el.pos)] = cell_t::Elevator;
     }
 
     // add the entry and exit
-    m_grid[prm->entry_pos + 1] = cell_t::Entry;
-    m_grid[prm->exit_pos + 1 + prm->exit_floor * width] = cell_t::Exit;
+    m_grid[cell_index(0, prm->entry_pos)] = cell_t::Entry;
+    m_grid[cell_index(prm->exit_floor, prm->exit_pos)] = cell_t::Exit;
 
     n_turns = elevators_used = clones_spawned = spawn_cd = 0;
 
@@ -95,7 +97,7 @@ bool DpMgr::input(Action a, std::ostream& _err = std::cerr)
     assert(n_turns <= prm->max_round);
     assert(clones_spawned <= prm->max_clones);
     assert(elevators_used <= prm->n_add_elevators);
-    assert(!(m_clones.front().floor == prm->exit_floor && m_clones.front().pos == prm->exit_pos));
+    assert(m_clones.empty() || !(m_clones.front().floor == prm->exit_floor && m_clones.front().pos == prm->exit_pos));
 
     if (a != Action::Wait && m_clones.empty()) {
         _err << "invalid action: no clones available"
@@ -106,8 +108,11 @@ bool DpMgr::input(Action a, std::ostream& _err = std::cerr)
         return false;
     }
 
+    if (a == Action::Wait)
+        return true;
+
     Entity clone = m_clones.front();
-    cell_t cell = m_grid[(clone.pos + 1) + (clone.floor * width)];
+    cell_t cell = m_grid[cell_index(clone.floor, clone.pos)];
 
     if (a == Action::Elevator) {
         if (player_elevators.size() == prm->n_add_elevators) {
@@ -123,11 +128,13 @@ bool DpMgr::input(Action a, std::ostream& _err = std::cerr)
         } else {
             Entity new_elev { Type::Elevator, clone.pos, clone.floor };
             player_elevators.push_back(new_elev);
+            m_grid[cell_index(clone.floor, clone.pos)] = cell_t::Elevator;
             m_clones.pop_front();
             ++elevators_used;
         }
     } else if (a == Action::Block) {
         blocked_clones.push_back(reverse(clone));
+        m_blocked[cell_index(clone.floor, clone.pos)] = true;
         m_clones.pop_front();
     }
 
@@ -160,9 +167,9 @@ void DpMgr::advance_clones()
         }
     }
 
-    if (!m_clones.empty() && at_wall(m_clones.front())) {
-        m_clones.pop_front();
-    }
+    // Every clone walking into a wall is destroyed, so that
+    // they all stay inside the grid
+    std::erase_if(m_clones, [this](const Entity& c) { return at_wall(c); });
 }
 
 bool DpMgr::at_wall(const Entity& c)
@@ -170,29 +177,35 @@ bool DpMgr::at_wall(const Entity& c)
     return c.pos == -1 || c.pos == width - 2;
 }
 
+int DpMgr::cell_index(int floor, int pos) const
+{
+    return (pos + 1) + floor * width;
+}
+
+bool DpMgr::is_inside(int pos) const
+{
+    return pos >= 0 && pos < prm->width;
+}
+
+/// NOTE: The player's elevators are marked in the grid as well,
+/// and the ones on the top floor lead nowhere
 bool DpMgr::at_elevator(const Entity& c)
 {
-    return (std::find_if(prm->elevators.begin(), prm->elevators.end(), [&c](const auto& e) {
-        return e.floor == c.floor && e.pos == c.pos;
-    }) != prm->elevators.end()
-        || std::find_if(player_elevators.begin(), player_elevators.end(), [&c](const auto& e) {
-               return e.floor == c.floor && e.pos == c.pos;
-           })
-            != player_elevators.end());
+    return is_inside(c.pos)
+        && c.floor + 1 < height
+        && m_grid[cell_index(c.floor, c.pos)] == cell_t::Elevator;
 }
 
 bool DpMgr::at_blocked(const Entity& c)
 {
-    return std::find_if(blocked_clones.begin(), blocked_clones.end(), [&c](const auto& b) {
-        return b.floor == c.floor && b.pos == c.pos;
-    }) != blocked_clones.end();
+    return is_inside(c.pos) && m_blocked[cell_index(c.floor, c.pos)];
 }
 
 bool DpMgr::should_reverse(const Entity& c)
 {
-    return std::find_if(blocked_clones.begin(), blocked_clones.end(), [&c](const auto& b) {
-        return b.floor == c.floor && (b.pos == pos_front(c) || b.pos == c.pos);
-    }) != blocked_clones.end();
+    const int front = pos_front(c);
+    return at_blocked(c)
+        || (is_inside(front) && m_blocked[cell_index(c.floor, front)]);
 }
 
 const Data* DpMgr::dump() const
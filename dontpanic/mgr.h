@@ -38,6 +38,8 @@ public:
 
 private:
     std::vector<cell_t> m_grid;
+    /// Whether a blocked clone stands on each cell of m_grid
+    std::vector<bool> m_blocked;
     std::deque<Entity> m_clones;
     std::vector<Entity> player_elevators;
     std::vector<Entity> blocked_clones;
@@ -52,6 +54,9 @@ private:
     int clones_spawned;
     int spawn_cd;
 
+    int cell_index(int floor, int pos) const;
+    bool is_inside(int pos) const;
+
     void advance_clones();
     bool at_wall(const Entity& c);
     bool at_elevator(const Entity& c);
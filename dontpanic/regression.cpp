@@ -0,0 +1,120 @@
+/// Headless regression run over the levels of the data directory.
+///
+/// USAGE: regression [data directory]
+///
+/// Every data/test*.txt level is solved by the agent and its actions
+/// are played through the DpMgr referee, which has to report a win.
+
+#include "agent.h"
+#include "dp.h"
+#include "mgr.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dp;
+
+namespace {
+
+struct Result {
+    bool won;
+    int turns;
+    int nodes;
+    double time_ms;
+};
+
+Result run(std::istream& _in)
+{
+    Result res {};
+
+    Game game;
+    game.init(_in);
+
+    auto start = std::chrono::steady_clock::now();
+    agent::search(game);
+    res.time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    res.nodes = agent::explored_nodes();
+
+    DpMgr mgr;
+    mgr.load(game);
+
+    while (mgr.pre_input()) {
+        Action action = agent::best_choice();
+        if (action == Action::None)
+            break;
+        if (!mgr.input(action, std::cerr))
+            break;
+        mgr.post_input();
+        ++res.turns;
+    }
+
+    res.won = mgr.status == DpMgr::status::Won;
+    return res;
+}
+
+/// The level number in a file name such as test12.txt
+int level_number(const std::filesystem::path& path)
+{
+    return std::stoi(path.stem().string().substr(4));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::filesystem::path data_dir = argc > 1 ? argv[1] : "data";
+
+    std::vector<std::filesystem::path> levels;
+    for (const auto& entry : std::filesystem::directory_iterator(data_dir)) {
+        const std::string name = entry.path().filename().string();
+        if (name.starts_with("test") && entry.path().extension() == ".txt")
+            levels.push_back(entry.path());
+    }
+    std::sort(levels.begin(), levels.end(), [](const auto& a, const auto& b) {
+        return level_number(a) < level_number(b);
+    });
+
+    if (levels.empty()) {
+        std::cerr << "No level found in " << data_dir << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::left << std::setw(14) << "level" << std::right
+              << std::setw(8) << "result"
+              << std::setw(8) << "turns"
+              << std::setw(8) << "nodes"
+              << std::setw(11) << "time (ms)" << '\n';
+
+    int n_failed = 0;
+    for (const auto& path : levels) {
+        std::ifstream ifs { path };
+        if (!ifs) {
+            std::cerr << "Failed to open input file " << path << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        Result res = run(ifs);
+        const bool in_time = res.time_ms <= max_time_ms;
+        n_failed += !(res.won && in_time);
+
+        std::cout << std::left << std::setw(14) << path.filename().string() << std::right
+                  << std::setw(8) << (res.won ? "won" : "FAILED")
+                  << std::setw(8) << res.turns
+                  << std::setw(8) << res.nodes
+                  << std::setw(11) << std::fixed << std::setprecision(3) << res.time_ms
+                  << '\n';
+
+        if (!in_time)
+            std::cout << "  over the " << max_time_ms << "ms time limit\n";
+    }
+
+    std::cout << levels.size() - n_failed << '/' << levels.size() << " levels passed" << std::endl;
+
+    return n_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -3,7 +3,6 @@
 
 #include <algorithm>
 #include <cassert>
-#include <deque>
 #include <iostream>
 #include <limits>
 #include <random>
@@ -11,7 +10,7 @@
 
 
 namespace {
-static constexpr int INFTY = 32000;
+static constexpr int INFTY = Agent::Unreachable;
 }
 
 Agent::Agent(Game &game)
@@ -30,16 +29,15 @@ Agent::Agent(Game &game)
 
 
 Move Agent::choose_move() {
-  if (m_game.m_cooldown > 0) { return {Move::Type::Wait, NULL_INDEX}; }
+  if (m_game.m_state.cooldown > 0) { return {Move::Type::Wait, NULL_INDEX}; }
 
-  m_game.get_bdry();
-  size_t n = m_game.m_outer_bdry.size();
+  size_t n = m_game.m_state.outer_bdry.size();
 
   if (n == 0) {
     return choose_random_move();
   }
 
-  return { Move::Type::Cut, m_game.m_outer_bdry[rand() % n] };
+  return { Move::Type::Cut, m_game.m_state.outer_bdry[rand() % n] };
   // if (move.index == NULL_INDEX) {
 
 
@@ -62,11 +60,10 @@ Move Agent::choose_random_move() const {
 
   //const auto& candidates = m_game.m_outer_bdry;
 
-  if (m_game.m_cooldown > 0) { return {Move::Type::Wait, NULL_INDEX}; }
+  if (m_game.m_state.cooldown > 0) { return {Move::Type::Wait, NULL_INDEX}; }
 
   cands.clear();
-  m_game.get_bdry();
-  size_t n = m_game.m_outer_bdry.size();
+  size_t n = m_game.m_state.outer_bdry.size();
 
   for (size_t c = 0; c < m_game.size(); ++c) {
     if (m_game.is_flammable(c)) {
@@ -89,7 +86,7 @@ size_t Agent::get_neighbour(size_t n, Direction d) const {
     case EAST:
     case WEST:  return n + d;
     case NORTH:
-    case SOUTH: return n + m_game.width() * d / 2;
+    case SOUTH: return n + int(m_game.width()) * d / 2;
     default: throw std::runtime_error("Invalid direction");
   }
 }
@@ -123,45 +120,55 @@ public:
 void Agent::generate_distance_map() {
   EdgeCost edge_cost{m_game};
 
-  std::deque<size_t> boundary;
-  std::vector<int> seen(m_game.size(), 0);
+  std::fill(m_distances.begin(), m_distances.end(), INFTY);
+  for (auto& p : m_parents) {
+    for (auto i : {EAST, NORTH, WEST, SOUTH}) { p[i] = INFTY; }
+  }
+
+  // Arrival times are popped in increasing order from a circular array
+  // of buckets, large enough to hold every time pushed ahead of the
+  // current one since edge costs are between 1 and the largest fire duration
+  const size_t n_buckets = std::max(Duration.fire_tree, Duration.fire_house) + 1;
+  m_buckets.resize(n_buckets);
+  for (auto& bucket : m_buckets) { bucket.clear(); }
 
   m_distances[m_game.fire_origin()] = 0;
-  boundary.push_back(m_game.fire_origin());
+  m_buckets[0].push_back(m_game.fire_origin());
+  size_t n_queued = 1;
 
-  while (not boundary.empty())
+  for (int distance = 0; n_queued > 0; ++distance)
   {
-    size_t current = boundary.front();
-    boundary.pop_front();
-    const int distance = m_distances[current];
+    auto& bucket = m_buckets[distance % n_buckets];
 
-    for (Direction d : {EAST, NORTH, WEST, SOUTH})
+    for (size_t current : bucket)
     {
-      const size_t nbh = get_neighbour(current, d);
-
-      // Avoid interior points
-      if (seen[nbh] > 0) {
+      // Skip the entries superseded by a shorter distance
+      if (m_distances[current] != distance) {
         continue;
       }
 
-      const int this_distance = distance + edge_cost(current, nbh);
+      for (Direction d : {EAST, NORTH, WEST, SOUTH})
+      {
+        const size_t nbh = get_neighbour(current, d);
+        const int cost = edge_cost(current, nbh);
 
-      // Mark points which are not flammable as seen and proceed to next nbh
-      if (this_distance >= EdgeCost::Infinite) {
-        seen[nbh] = 1;
-        continue;
-      }
+        if (cost >= EdgeCost::Infinite) {
+          continue;
+        }
 
-      // Otherwise, add nbh to the end of the queue and update stats
-      boundary.push_back(nbh);
+        // The square is final, so this is the exact arrival time through it
+        const int this_distance = distance + cost;
+        m_parents[nbh][-d] = this_distance;
 
-      m_parents[nbh][-d] = this_distance;
-      if (this_distance < m_distances[nbh]) {
-        m_distances[nbh] = this_distance;
+        if (this_distance < m_distances[nbh]) {
+          m_distances[nbh] = this_distance;
+          m_buckets[this_distance % n_buckets].push_back(nbh);
+          ++n_queued;
+        }
       }
     }
 
-    // Add to seen set once a square's four neighbours are processed
-    seen[current] = 1;
+    n_queued -= bucket.size();
+    bucket.clear();
   }
 }
@@ -27,6 +27,9 @@ class ParentDistances;
  */
 class Agent {
 public:
+  /** Distance of the squares the fire never reaches. */
+  static constexpr int Unreachable = 32000;
+
   /**
    * Construct an agent.
    *
@@ -51,10 +54,13 @@ public:
    * Generate a lookup table for the number of turns the fire
    * takes to reach each square of the grid.
    *
-   * Perform a BFS traversal of the grid starting at the
-   * fire's origin, incrementing the distance according to
-   * the squares' type. Also record the shortest distance
+   * Perform Dial's shortest path algorithm starting at the
+   * fire's origin, the fire taking the duration of a square's
+   * type to cross it. Also record the shortest distance
    * through each parent.
+   *
+   * NOTE: Distances are the turns at which squares catch fire
+   * when nothing is cut, Unreachable for squares it never reaches.
    */
   void generate_distance_map();
 
@@ -92,6 +98,9 @@ private:
   /** The distance value at each parent */
   std::vector<ParentDistances> m_parents;
 
+  /** Bucket queue of generate_distance_map(), kept between calls */
+  std::vector<std::vector<size_t>> m_buckets;
+
   /**
    * Get the index of interior squares' neighbours.
    *
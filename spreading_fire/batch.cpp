@@ -0,0 +1,270 @@
+/**
+ * Headless evaluation of the planner on many maps.
+ *
+ * Usage: sf_batch [n_random [n_jobs [inputs...]]]
+ *
+ * Plays the planner of main.cpp on every input file (directories are
+ * searched for .txt files) and on `n_random' random maps (default 0),
+ * running `n_jobs' games at a time (default: number of cores). The
+ * cores are shared between the games: each search runs on
+ * number of cores / `n_jobs' threads, so that the planner's time budget
+ * buys the same search whatever `n_jobs'.
+ *
+ * NOTE: The cell parameters are globals (see cell.h) and the search
+ * keeps its own state, so the games run in separate processes.
+ */
+#include "agent.h"
+#include "game.h"
+#include "search.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Job {
+  std::string name;
+  std::string input;
+};
+
+struct Result {
+  size_t width;
+  size_t height;
+  int value;
+  int idle_value;
+  int total_value;
+  size_t n_cuts;
+  double plan_ms;
+  unsigned int turns;
+  /// An invalid cut stopped the game
+  bool failed;
+};
+
+/** Input for a random map surrounded by safe cells. */
+std::string random_input(std::mt19937& eng) {
+  std::uniform_int_distribution<int> duration(1, 8);
+  std::uniform_int_distribution<int> side(8, 50);
+  std::uniform_int_distribution<int> type(0, 19);
+
+  const int width = side(eng);
+  const int height = side(eng);
+  const int x0 = std::uniform_int_distribution<int>(1, width - 2)(eng);
+  const int y0 = std::uniform_int_distribution<int>(1, height - 2)(eng);
+
+  std::ostringstream os;
+  os << duration(eng) << ' ' << duration(eng) << ' ' << 5 << '\n'
+     << duration(eng) << ' ' << duration(eng) << ' ' << 50 << '\n'
+     << width << ' ' << height << '\n'
+     << x0 << ' ' << y0 << '\n';
+
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const bool border = x == 0 || y == 0 || x == width - 1 || y == height - 1;
+      const int t = type(eng);
+      os << (border ? '#' : x == x0 && y == y0 ? '.' : t < 3 ? '#' : t < 5 ? 'X' : '.');
+    }
+    os << '\n';
+  }
+  return os.str();
+}
+
+/** Play the planner on one map, the same way main.cpp does. */
+Result run(const std::string& input) {
+  std::istringstream is{input};
+  Game game;
+  game.init_input(is);
+
+  Result res{};
+  res.width = game.width();
+  res.height = game.height();
+  for (size_t n = 0; n < game.size(); ++n) {
+    res.total_value += game.value(n);
+  }
+
+  Game idle{game};
+  while (not idle.is_terminal()) {
+    idle.apply(WAIT);
+  }
+  res.idle_value = idle.current_value();
+
+  auto start = Clock::now();
+  Agent agent(game);
+  search::init(game, agent);
+  std::vector<Move> moves = search::get_moves(game);
+  res.plan_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  size_t m = 0;
+  while (not game.is_terminal()) {
+    Move move = m < moves.size() && game.is_ready() ? moves[m++] : WAIT;
+
+    if (move.type == Move::Type::Cut && not game.is_flammable(move.index)) {
+      std::cerr << "Invalid cut " << game.format_move(move) << std::endl;
+      res.failed = true;
+      break;
+    }
+    game.apply(move);
+  }
+
+  res.value = game.current_value();
+  res.n_cuts = m;
+  res.turns = game.turn();
+  return res;
+}
+
+/** Run the job in a child process, whose result can be read from the returned descriptor. */
+std::pair<pid_t, int> spawn(const Job& job, unsigned n_threads) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return {-1, -1};
+  }
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    // Keep the search's debug output out of the report
+    std::freopen("/dev/null", "w", stderr);
+
+    search::set_n_threads(n_threads);
+    Result res = run(job.input);
+    bool okay = write(fds[1], &res, sizeof(res)) == sizeof(res);
+    close(fds[1]);
+    _exit(okay ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+
+  close(fds[1]);
+  return {pid, fds[0]};
+}
+
+}  // namespace
+
+
+int main(int argc, char *argv[]) {
+  const int n_random = argc > 1 ? std::stoi(argv[1]) : 0;
+  const unsigned int n_jobs = argc > 2 && std::stoi(argv[2]) > 0
+    ? std::stoi(argv[2])
+    : std::max(1u, std::thread::hardware_concurrency());
+  const unsigned int n_threads =
+    std::max(1u, std::thread::hardware_concurrency() / n_jobs);
+
+  std::vector<Job> jobs;
+
+  for (int i = 3; i < argc; ++i) {
+    std::vector<std::filesystem::path> paths;
+    if (std::filesystem::is_directory(argv[i])) {
+      for (const auto& entry : std::filesystem::directory_iterator(argv[i])) {
+        if (entry.path().extension() == ".txt") {
+          paths.push_back(entry.path());
+        }
+      }
+      std::sort(paths.begin(), paths.end());
+    } else {
+      paths.push_back(argv[i]);
+    }
+
+    for (const auto& path : paths) {
+      std::ifstream ifs{path};
+      if (not ifs) {
+        std::cerr << "Failed to open input file " << path << std::endl;
+        return EXIT_FAILURE;
+      }
+      std::stringstream ss;
+      ss << ifs.rdbuf();
+      jobs.push_back({path.filename().string(), ss.str()});
+    }
+  }
+
+  std::mt19937 eng{ 2023 };
+  for (int i = 0; i < n_random; ++i) {
+    jobs.push_back({"random" + std::to_string(i), random_input(eng)});
+  }
+
+  if (jobs.empty()) {
+    std::cerr << "Usage: " << argv[0] << " [n_random [n_jobs [inputs...]]]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Result> results(jobs.size());
+  std::vector<bool> done(jobs.size(), false);
+  std::vector<std::pair<pid_t, int>> running(jobs.size(), {-1, -1});
+  size_t next = 0, n_running = 0;
+
+  while (next < jobs.size() || n_running > 0) {
+    while (next < jobs.size() && n_running < n_jobs) {
+      running[next] = spawn(jobs[next], n_threads);
+      ++next;
+      ++n_running;
+    }
+
+    int status;
+    pid_t pid = wait(&status);
+    if (pid < 0) {
+      break;
+    }
+    for (size_t j = 0; j < next; ++j) {
+      if (running[j].first == pid) {
+        done[j] = read(running[j].second, &results[j], sizeof(Result)) == sizeof(Result);
+        close(running[j].second);
+        --n_running;
+      }
+    }
+  }
+
+  std::cout << std::left << std::setw(16) << "map" << std::right
+            << std::setw(8) << "size"
+            << std::setw(9) << "value"
+            << std::setw(9) << "no cut"
+            << std::setw(9) << "total"
+            << std::setw(6) << "cuts"
+            << std::setw(7) << "turns"
+            << std::setw(11) << "plan ms"
+            << std::setw(13) << "mean ms/cut" << '\n';
+
+  long long sum_value = 0, sum_total = 0;
+  double sum_plan = 0;
+  size_t n_played = 0;
+  for (size_t j = 0; j < jobs.size(); ++j) {
+    std::cout << std::left << std::setw(16) << jobs[j].name << std::right;
+    const Result& r = results[j];
+    if (not done[j] or r.failed) {
+      std::cout << "  FAILED\n";
+      continue;
+    }
+    std::cout << std::setw(8) << (std::to_string(r.width) + 'x' + std::to_string(r.height))
+              << std::setw(9) << r.value
+              << std::setw(9) << r.idle_value
+              << std::setw(9) << r.total_value
+              << std::setw(6) << r.n_cuts
+              << std::setw(7) << r.turns
+              << std::setw(11) << std::fixed << std::setprecision(1) << r.plan_ms
+              << std::setw(13) << std::setprecision(3)
+              << (r.n_cuts > 0 ? r.plan_ms / r.n_cuts : 0.0) << '\n';
+    sum_value += r.value;
+    sum_total += r.total_value;
+    sum_plan += r.plan_ms;
+    ++n_played;
+  }
+
+  std::cout << "\ntotal value " << sum_value << " / " << sum_total
+            << ", mean planning time " << std::setprecision(1)
+            << (n_played > 0 ? sum_plan / n_played : 0.0) << " ms on "
+            << n_threads << (n_threads == 1 ? " thread" : " threads")
+            << std::endl;
+
+  return n_played == jobs.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -10,50 +10,40 @@ TreeT Tree;
 HouseT House;
 
 
-Cell::Cell(Type type, Status status, const size_t n)
-    : m_type{type}, m_status{status}, m_index{n}
+Cell::Cell(Type type, Status status)
+    : m_state{uint8_t(uint8_t(type) | uint8_t(status) << StatusShift)}
 {
 
 }
 
 
 void Cell::start_cutting() {
-    assert(m_type != Type::Safe && m_status != Cell::Status::OnFire);
-    m_status = Status::Cutting;
-    m_type = Type::Safe;
-    m_cutting_countdown =
-        m_type == Type::Tree ? Tree.DurationCut - 1: House.DurationCut - 1;
+    assert(type() != Type::Safe && status() != Cell::Status::OnFire);
+    *this = Cell{Type::Safe, Status::Cutting};
   }
 
 
 void Cell::set_on_fire() {
-    assert(m_type != Type::Safe);
-    m_status = Status::OnFire;
-    m_fire_countdown =
-        m_type == Type::Tree ? Tree.DurationFire - 1: House.DurationFire - 1;
+    assert(type() != Type::Safe);
+    set_status(Status::OnFire);
   }
 
-void Cell::set_safe() { m_type = Type::Safe; }
+void Cell::set_safe() { *this = Cell{Type::Safe, status()}; }
 
+void Cell::set_status(Status status) { *this = Cell{type(), status}; }
 
-bool Cell::update() {
-    if (m_status == Status::OnFire) {
-      if (--m_fire_countdown == 0) {
-        m_status = Status::Burnt;
-        return true;
-      }
-    } else if (m_status == Status::Cutting) {
-      if (--m_cutting_countdown == 0) {
-        m_status = Status::Cut;
-        return true;
-      }
-    }
-    return false;
+
+int Cell::duration_fire() const {
+    return type() == Type::Tree ? Tree.DurationFire : House.DurationFire;
+}
+
+int Cell::duration_cut() const {
+    return type() == Type::Tree ? Tree.DurationCut : House.DurationCut;
 }
 
 int Cell::value() const {
-    if (m_status == Status::NoFire) {
-      switch (m_type) {
+    if (status() == Status::NoFire) {
+      switch (type()) {
       case Type::Safe:
         return 0;
       case Type::Tree:
@@ -22,6 +22,9 @@ extern HouseT House;
 /**
  * Store the Type and Status of a cell by combining both enums
  * into one unsigned 8 bit integers with a bitwise OR operation.
+ *
+ * NOTE: The countdowns of the cells on fire or being cut live
+ * in the Game's state, so that a Cell is a single byte.
  */
 class Cell {
 public:
@@ -38,13 +41,14 @@ public:
     Cutting = 16
   };
 
-  Cell(Type type, Status status, const size_t n);
-
-  /** Return the Type part of the cell's state. */
-  Status status() const { return m_status; }
+  Cell() = default;
+  Cell(Type type, Status status);
 
   /** Return the Status part of the cell's state. */
-  Type type() const { return m_type; }
+  Status status() const { return Status(m_state >> StatusShift); }
+
+  /** Return the Type part of the cell's state. */
+  Type type() const { return Type(m_state & TypeMask); }
 
   /** Change the type to safe (cell is burned or cut) */
   void start_cutting();
@@ -55,40 +59,22 @@ public:
   /** Set the cell to type safe */
   void set_safe();
 
-  /** The time before the cell is burnt, or -1 if no fire. */
-  int fire_countdown() const { return m_fire_countdown; }
-
-  /** The time before the cell is cut, or -1 if not cutting. */
-  int cutting_countdown() const { return m_cutting_countdown; }
+  /** Change the status, keeping the type */
+  void set_status(Status status);
 
-  /**
-   * Decrement any necessary countdown, set type and status if burnt
-   *  or cut.
-   * In case one of the two countdowns gets to 0, return true.
-   */
-  bool update();
+  /** The number of turns it burns for, or to cut it. */
+  int duration_fire() const;
+  int duration_cut() const;
 
   /** Return the value, or 0 if the cell is consumed. */
   int value() const;
 
-
-    size_t index() const { return m_index; }
-
 private:
-  /** Both the type and status are encoded in an 8-bit integer */
-  Type m_type;
-
-  /** Whether the cell is on fire or not */
-  Status m_status;
+  static constexpr uint8_t TypeMask = 0b111;
+  static constexpr int StatusShift = 3;
 
-  /** The cell's index */
-  const size_t m_index;
-
-  /** The cell's countdown until it gets Burnt status */
-  int m_fire_countdown{-1};
-
-  /** The cell's countdown until it gets Cut status */
-  int m_cutting_countdown{-1};
+  /** Both the type and status are encoded in an 8-bit integer */
+  uint8_t m_state;
 };
 
 extern std::ostream& operator<<(std::ostream& out, Cell::Type type);
@@ -0,0 +1,218 @@
+#include "firebreak.h"
+#include "game.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+
+namespace firebreak {
+
+MaxFlow::MaxFlow(size_t n_nodes)
+  : m_n{n_nodes}
+  , m_adj(n_nodes)
+  , m_height(n_nodes, 0)
+  , m_excess(n_nodes, 0)
+{
+}
+
+void MaxFlow::add_edge(size_t from, size_t to, int64_t capacity) {
+  m_adj[from].push_back(m_edges.size());
+  m_edges.push_back({to, capacity});
+  m_adj[to].push_back(m_edges.size());
+  m_edges.push_back({from, 0});
+}
+
+void MaxFlow::global_relabel(size_t sink) {
+  std::fill(m_height.begin(), m_height.end(), m_n);
+  std::vector<size_t> queue{sink};
+  m_height[sink] = 0;
+
+  for (size_t i = 0; i < queue.size(); ++i) {
+    const size_t u = queue[i];
+    for (size_t e : m_adj[u]) {
+      const size_t v = m_edges[e].to;
+      // Nodes which can push to u through the reverse edge
+      if (m_edges[e ^ 1].capacity > 0 && m_height[v] == m_n) {
+        m_height[v] = m_height[u] + 1;
+        queue.push_back(v);
+      }
+    }
+  }
+}
+
+int64_t MaxFlow::run(size_t source, size_t sink) {
+  std::fill(m_excess.begin(), m_excess.end(), 0);
+  global_relabel(sink);
+  m_height[source] = m_n;
+
+  std::vector<size_t> count(2 * m_n + 1, 0);
+  for (size_t u = 0; u < m_n; ++u) { ++count[m_height[u]]; }
+
+  std::vector<size_t> active;
+  std::vector<size_t> current(m_n, 0);
+
+  auto push = [&](size_t e, int64_t delta) {
+    const size_t v = m_edges[e].to;
+    m_edges[e].capacity -= delta;
+    m_edges[e ^ 1].capacity += delta;
+    if (m_excess[v] == 0 && v != source && v != sink && m_height[v] < m_n) {
+      active.push_back(v);
+    }
+    m_excess[v] += delta;
+  };
+
+  for (size_t e : m_adj[source]) {
+    m_excess[source] -= m_edges[e].capacity;
+    push(e, m_edges[e].capacity);
+  }
+
+  // Only the nodes which can still reach the sink are discharged,
+  // which is enough for finding a minimum cut
+  for (size_t i = 0; i < active.size(); ++i) {
+    const size_t u = active[i];
+
+    while (m_excess[u] > 0 && m_height[u] < m_n) {
+      if (current[u] == m_adj[u].size()) {
+        // Relabel
+        const size_t old = m_height[u];
+        size_t height = 2 * m_n;
+        for (size_t e : m_adj[u]) {
+          if (m_edges[e].capacity > 0) {
+            height = std::min(height, m_height[m_edges[e].to] + 1);
+          }
+        }
+        --count[old];
+        m_height[u] = std::min(height, 2 * m_n);
+        ++count[m_height[u]];
+        current[u] = 0;
+
+        // Gap: nothing above `old' can reach the sink anymore
+        if (count[old] == 0 && old < m_n) {
+          for (size_t v = 0; v < m_n; ++v) {
+            if (m_height[v] > old && m_height[v] < m_n) {
+              --count[m_height[v]];
+              m_height[v] = m_n;
+              ++count[m_n];
+            }
+          }
+        }
+        continue;
+      }
+
+      const size_t e = m_adj[u][current[u]];
+      const Edge& edge = m_edges[e];
+      if (edge.capacity > 0 && m_height[u] == m_height[edge.to] + 1) {
+        const int64_t delta = std::min(m_excess[u], edge.capacity);
+        m_excess[u] -= delta;
+        push(e, delta);
+      }
+      if (m_edges[e].capacity == 0 || m_excess[u] > 0) {
+        ++current[u];
+      }
+    }
+  }
+
+  global_relabel(sink);
+  return m_excess[sink];
+}
+
+
+namespace {
+
+/** Penalty for each cut, below the smallest difference of values. */
+constexpr int64_t cut_penalty = 1;
+
+/** Number of times the cut is computed again before giving up on the late cells. */
+constexpr int max_rounds = 64;
+
+}  // namespace
+
+
+std::vector<size_t> plan(const Game &game, const std::vector<int> &arrival) {
+  const size_t n = game.size();
+  const size_t source = 2 * n;
+  const size_t sink = 2 * n + 1;
+  auto in = [](size_t v) { return 2 * v; };
+  auto out = [](size_t v) { return 2 * v + 1; };
+
+  // Values are scaled so that the cut penalties never outweigh one value unit
+  const int64_t scale = n + 1;
+
+  // More than any finite cut, small enough for the excesses not to overflow
+  int64_t infinite = n * cut_penalty + 1;
+  for (size_t v = 0; v < n; ++v) {
+    infinite += scale * game.value(v);
+  }
+
+  std::vector<char> uncuttable(n, 0);
+  std::vector<size_t> cuts;
+
+  for (int round = 0; round < max_rounds; ++round) {
+    MaxFlow flow{2 * n + 2};
+
+    for (size_t v = 0; v < n; ++v) {
+      if (not game.is_flammable(v)) {
+        continue;
+      }
+      flow.add_edge(in(v), sink, scale * game.value(v));
+      flow.add_edge(in(v), out(v), uncuttable[v] ? infinite : cut_penalty);
+      for (auto o : game.offsets(v)) {
+        if (game.is_flammable(o)) {
+          flow.add_edge(out(v), in(o), infinite);
+        }
+      }
+    }
+    for (auto b : game.state().bdry) {
+      flow.add_edge(source, out(b), infinite);
+      for (auto o : game.offsets(b)) {
+        if (game.is_flammable(o)) {
+          flow.add_edge(out(b), in(o), infinite);
+        }
+      }
+    }
+
+    flow.run(source, sink);
+
+    cuts.clear();
+    for (size_t v = 0; v < n; ++v) {
+      if (game.is_flammable(v) && flow.source_side(in(v)) && not flow.source_side(out(v))) {
+        cuts.push_back(v);
+      }
+    }
+
+    // Earliest deadline first, each cut starting before the fire arrives
+    std::sort(cuts.begin(), cuts.end(), [&](size_t a, size_t b) {
+      return arrival[a] < arrival[b];
+    });
+
+    int turn = game.turn();
+    auto late = cuts.end();
+    for (auto it = cuts.begin(); it != cuts.end(); ++it) {
+      if (turn >= arrival[*it]) {
+        late = it;
+        break;
+      }
+      turn += game.duration_cut(*it);
+    }
+
+    if (late == cuts.end()) {
+      return cuts;
+    }
+    uncuttable[*late] = 1;
+  }
+
+  // Keep the cells which can still be cut in time
+  std::vector<size_t> ret;
+  int turn = game.turn();
+  for (size_t v : cuts) {
+    if (turn < arrival[v]) {
+      ret.push_back(v);
+      turn += game.duration_cut(v);
+    }
+  }
+  return ret;
+}
+
+}  // namespace firebreak
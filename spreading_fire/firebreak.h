@@ -0,0 +1,66 @@
+/**
+ * Choice of the cells to cut as a minimum cut problem.
+ */
+#ifndef FIREBREAK_H_
+#define FIREBREAK_H_
+
+#include "game.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace firebreak {
+
+/**
+ * Maximum flow / minimum cut of a directed graph, computed
+ * with the FIFO push-relabel algorithm and the gap heuristic.
+ */
+class MaxFlow {
+public:
+  explicit MaxFlow(size_t n_nodes);
+
+  void add_edge(size_t from, size_t to, int64_t capacity);
+
+  /** Compute the value of a maximum flow from `source' to `sink'. */
+  int64_t run(size_t source, size_t sink);
+
+  /** After run(), whether `node' is on the source's side of a minimum cut. */
+  bool source_side(size_t node) const { return m_height[node] >= m_n; }
+
+private:
+  struct Edge {
+    size_t to;
+    int64_t capacity;
+  };
+
+  size_t m_n;
+  /** Residual edges, the reverse of edge e being e ^ 1 */
+  std::vector<Edge> m_edges;
+  std::vector<std::vector<size_t>> m_adj;
+  std::vector<size_t> m_height;
+  std::vector<int64_t> m_excess;
+
+  void global_relabel(size_t sink);
+};
+
+/**
+ * The cells to cut for keeping the fire away from the most
+ * value, in the order they have to be cut.
+ *
+ * Each cell is split into an entry and an exit node, the entry
+ * being on the source's side when the cell is lost and the exit
+ * when it spreads the fire. Cutting a cell is the edge between
+ * the two, so that a minimum cut trades the value burnt against
+ * the cells to cut. Cuts are then scheduled by the fire's arrival
+ * times, and the cells which can't be cut in time are made
+ * uncuttable before solving again.
+ *
+ * @param game     Game in which the next cut can be given.
+ * @param arrival  Turns at which the fire reaches the cells, see
+ *   Agent::generate_distance_map.
+ */
+std::vector<size_t> plan(const Game &game, const std::vector<int> &arrival);
+
+}  // namespace firebreak
+
+#endif // FIREBREAK_H_
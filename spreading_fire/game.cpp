@@ -6,7 +6,6 @@
 #include <functional>
 #include <limits>
 #include <numeric>
-#include <set>
 #include <tuple>
 
 
@@ -15,7 +14,7 @@ Point Game::coords(size_t ndx) const {
 }
 
 int Game::duration_cut(size_t ndx) const {
-  switch (m_cells[ndx].type()) {
+  switch (m_state.cells[ndx].type()) {
     case Cell::Type::Tree: return Tree.DurationCut;
     case Cell::Type::House: return House.DurationCut;
     default: return std::numeric_limits<int>::infinity();
@@ -23,7 +22,7 @@ int Game::duration_cut(size_t ndx) const {
 }
 
 int Game::duration_fire(size_t ndx) const {
-    switch (m_cells[ndx].type()) {
+    switch (m_state.cells[ndx].type()) {
       case Cell::Type::Tree: return Tree.DurationFire;
       case Cell::Type::House: return House.DurationFire;
       default: return std::numeric_limits<int>::infinity();
@@ -32,40 +31,23 @@ int Game::duration_fire(size_t ndx) const {
 
 namespace {
 
-template<typename Cont>
 class CellInserter {
-  Cont& m_cont;
+  Game::State& m_state;
 public:
-  CellInserter(Cont& cont) : m_cont{cont} {}
+  CellInserter(Game::State& state) : m_state{state} {}
 
   auto operator()(size_t n) {
     return [&, n](Cell::Type t) {
-      return m_cont.emplace_back(t, Cell::Status::NoFire, n);
+      m_state.cells[n] = Cell{t, Cell::Status::NoFire};
+      m_state.countdown[n] = -1;
     };
   }
 };
 
-template<typename Cont>
-inline CellInserter<Cont> make_cell_inserter(Cont& cont) { return CellInserter<Cont>(cont); }
+inline CellInserter make_cell_inserter(Game::State& state) { return CellInserter(state); }
 
 }  // namespace
 
-Game::Game(const Game& other)
-  : m_width{other.m_width}
-  , m_height{other.m_height}
-  , m_fire_origin{other.m_fire_origin}
-  , m_cooldown{other.m_cooldown}
-  , m_turn{other.m_turn}
-  , m_cells{other.m_cells}
-{
-}
-
-Game& Game::operator=(const Game& other) {
-  Game _game(other);
-  std::swap(_game, *this);
-  return *this;
-}
-
 void Game::init_input(std::istream &is) {
   is >> Tree.DurationCut >> Tree.DurationFire >> Tree.Value;
   is >> House.DurationCut >> House.DurationFire >> House.Value;
@@ -73,12 +55,11 @@ void Game::init_input(std::istream &is) {
   is >> m_fire_origin.x >> m_fire_origin.y;
 
   m_fire_progress.resize(size(), -1);
-  m_bdry.reserve(size());
-  m_outer_bdry.reserve(size());
-  m_cells.reserve(size());
+  m_state.width = m_width;
+  m_state.size = size();
 
   std::string buf;
-  auto cell_inserter = make_cell_inserter(m_cells);
+  auto cell_inserter = make_cell_inserter(m_state);
 
   for (size_t y = 0; y < m_height; ++y) {
     is >> buf;
@@ -94,13 +75,18 @@ void Game::init_input(std::istream &is) {
 
   const size_t fire_origin_ndx = index(m_fire_origin.x, m_fire_origin.y);
   m_fire_progress[fire_origin_ndx] = 0;
-  m_cells[fire_origin_ndx].set_on_fire();
-  m_cooldown = 0;
-  m_turn = 0;
+  m_state.cooldown = 0;
+  m_state.turn = 0;
+  m_state.cutting = NULL_INDEX;
+  m_state.value = 0;
+  for (size_t n = 0; n < size(); ++n) {
+    m_state.value += m_state.cells[n].value();
+  }
+  m_state.start_fire(fire_origin_ndx);
 }
 
 void Game::turn_input(std::istream &is) {
-  is >> m_cooldown;
+  is >> m_state.cooldown;
   for (size_t y = 0; y < m_height; ++y) {
     for (size_t x = 0; x < m_width; ++x) {
       size_t n = index(x, y);
@@ -122,8 +108,8 @@ bool Game::test_against_turn_input() {
       size_t n = index(x, y);
       int fp = m_fire_progress[n];
 
-      Cell::Type type = m_cells[n].type();
-      Cell::Status status = m_cells[n].status();
+      Cell::Type type = m_state.cells[n].type();
+      Cell::Status status = m_state.cells[n].status();
 
       // Cell is a safe cell.
       if (fp == -2) {
@@ -169,88 +155,103 @@ bool Game::test_against_turn_input() {
   return okay;
 }
 
-int Game::current_value() const {
-  int ret = 0;
-  for (size_t i = 0; i < size(); ++i) {
-    ret += m_cells[i].value();
-  }
-  return ret;
-  // return std::accumulate(m_cells.begin(), m_cells.end(), 0, [](const auto& c){
-  //   return c.value();
-  // });
-}
+void Game::State::start_fire(size_t n) {
+  bdry.clear();
+  outer_bdry.clear();
+  in_outer_bdry.reset();
 
-void Game::get_bdry() {
-  m_bdry.clear();
-  m_outer_bdry.clear();
-  std::set<size_t> outer_buf;
-  for (size_t n = 0; n < size(); ++n) {
-    if (m_cells[n].status() == Cell::Status::OnFire) {
-      m_bdry.push_back(n);
-      auto ofs = offsets(n);
-      for (auto o : ofs) {
-        // Only take candidates for cutting here (candidates
-        // for propagating fire)
-        if (m_cells[o].type() != Cell::Type::Safe &&
-            m_cells[o].status() == Cell::Status::NoFire) {
-          auto [_, ok] = outer_buf.insert(o);
-          if (ok) {
-            m_outer_bdry.push_back(o);
-          }
-        }
-      }
+  value -= cells[n].value();
+  cells[n].set_on_fire();
+  countdown[n] = cells[n].duration_fire();
+  bdry.push_back(n);
+
+  for (auto o : offsets(n)) {
+    if (is_flammable(o)) {
+      in_outer_bdry.set(o);
+      outer_bdry.push_back(o);
     }
   }
 }
 
-void Game::expand_fire(size_t n) {
+void Game::State::expand_fire(size_t n) {
   for (auto of : offsets(n)) {
-    if (is_flammable(of)) {
-        m_cells[of].set_on_fire();
+    if (not is_flammable(of)) {
+      continue;
+    }
+    value -= cells[of].value();
+    cells[of].set_on_fire();
+    countdown[of] = cells[of].duration_fire();
+    bdry.push_back(of);
+
+    // Only take candidates for cutting here (candidates
+    // for propagating fire)
+    for (auto o : offsets(of)) {
+      if (is_flammable(o) && not in_outer_bdry[o]) {
+        in_outer_bdry.set(o);
+        outer_bdry.push_back(o);
+      }
     }
   }
 }
 
-void Game::apply(const Move &move) {
+void Game::State::apply(const Move &move) {
   if (move.type == Move::Type::Cut) {
-    assert(m_cooldown == 0 && "Failed at non-zero cutting countdown");
-    assert(m_cells[move.index].type() != Cell::Type::Safe &&
+    assert(cooldown == 0 && "Failed at non-zero cutting countdown");
+    assert(cells[move.index].type() != Cell::Type::Safe &&
            "Failed when trying to cut a Safe cell.");
-    assert(m_cells[move.index].status() == Cell::Status::NoFire &&
+    assert(cells[move.index].status() == Cell::Status::NoFire &&
            "Failed when trying to cut a cell on fire.");
 
-    m_cells[move.index].start_cutting();
-    m_cooldown = m_cells[move.index].cutting_countdown();
+    value -= cells[move.index].value();
+    // The next cut can be given duration_cut() turns later, the cooldown
+    // read on the next turn being duration_cut() - 1
+    countdown[move.index] = cells[move.index].duration_cut();
+    cells[move.index].start_cutting();
+    cooldown = countdown[move.index] - 1;
+    cutting = move.index;
   }
   else {
-    m_cooldown -= 1;
+    cooldown -= 1;
   }
 
-  for (size_t n = 0; n < size(); ++n) {
-    if (m_cells[n].update()) {
-      switch (m_cells[n].status()) {
-        case Cell::Status::Burnt:
-          expand_fire(n);
-          break;
-        case Cell::Status::Cut:
-          m_cooldown = 0;
-          break;
-        default:
-          assert(false && "Failed when update() returned true"
-                 "without the status being Burnt or Cut");
-      }
+  if (cutting != NULL_INDEX && --countdown[cutting] == 0) {
+    cells[cutting].set_status(Cell::Status::Cut);
+    cutting = NULL_INDEX;
+    cooldown = 0;
+  }
+
+  // Cells catching fire during this turn only start burning on the next one
+  IndexList<MAX_CELLS> burnt;
+  burnt.clear();
+  size_t n_kept = 0;
+  for (size_t i = 0; i < bdry.size(); ++i) {
+    const size_t n = bdry[i];
+    if (--countdown[n] == 0) {
+      cells[n].set_status(Cell::Status::Burnt);
+      burnt.push_back(n);
+    } else {
+      bdry[n_kept++] = n;
     }
   }
-  ++m_turn;
-}
+  bdry.truncate(n_kept);
 
-bool Game::is_terminal() const {
-  for (const auto& c : m_cells) {
-    if (c.type() != Cell::Type::Safe && c.status() == Cell::Status::NoFire) {
-      return false;
+  for (auto n : burnt) {
+    expand_fire(n);
+  }
+
+  // Drop the cells which caught fire or were cut from the outer boundary
+  n_kept = 0;
+  for (size_t i = 0; i < outer_bdry.size(); ++i) {
+    const size_t n = outer_bdry[i];
+    if (is_flammable(n)) {
+      outer_bdry[n_kept++] = n;
+    } else {
+      in_outer_bdry.reset(n);
     }
   }
-  return true;
+  outer_bdry.truncate(n_kept);
+
+  ++turn;
 }
 
 std::string Game::format_move(const Move& move) {
@@ -5,11 +5,18 @@
 #include "point.h"
 
 #include <array>
+#include <bitset>
+#include <cstdint>
 #include <iosfwd>
+#include <string>
+#include <type_traits>
 #include <vector>
 
+/** The largest possible number of cells. */
+constexpr size_t MAX_CELLS = 50 * 50;
+
 /** One more than the largest possible index. */
-constexpr size_t NULL_INDEX = 50 * 50 + 1;
+constexpr size_t NULL_INDEX = MAX_CELLS + 1;
 
 struct Move {
   enum class Type { Wait, Cut };
@@ -19,28 +26,101 @@ struct Move {
 constexpr Move WAIT{Move::Type::Wait, NULL_INDEX};
 
 
-class Game {
+/**
+ * List of cell indices with a fixed capacity, so that it can
+ * live inside a plain data structure.
+ */
+template<size_t N>
+class IndexList {
 public:
-  using cell_iterator = std::vector<Cell>::const_iterator;
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  size_t operator[](size_t i) const { return m_data[i]; }
+  uint16_t& operator[](size_t i) { return m_data[i]; }
+  const uint16_t* begin() const { return m_data.data(); }
+  const uint16_t* end() const { return m_data.data() + m_size; }
+
+  void clear() { m_size = 0; }
+  void push_back(size_t n) { m_data[m_size++] = uint16_t(n); }
+  /** Keep only the first n indices. */
+  void truncate(size_t n) { m_size = uint16_t(n); }
+
+private:
+  std::array<uint16_t, N> m_data;
+  uint16_t m_size;
+};
 
-  Game() = default;
-  Game(const Game&);
-  Game& operator=(const Game&);
+
+class Game {
+public:
+  /**
+   * Everything that changes during a game.
+   *
+   * It is plain data so that rollouts can clone it with a
+   * memcpy, and it knows the grid's width so that it can be
+   * simulated without the Game object.
+   *
+   * The boundaries of the fire are kept up to date by apply(),
+   * which only visits the cells on fire and the one being cut.
+   */
+  struct State {
+    size_t width;
+    size_t size;
+    int cooldown;
+    unsigned int turn;
+    /** Sum of the values of the cells neither burning nor cut. */
+    int value;
+    /** The last cell given to cut, or NULL_INDEX. */
+    size_t cutting;
+    std::array<Cell, MAX_CELLS> cells;
+
+    /**
+     * Turns left before a cell on fire is burnt or a cell being cut is cut.
+     *
+     * NOTE: A cell stays on fire during its whole fire duration, so the
+     * fire takes exactly duration_fire() turns to cross it.
+     */
+    std::array<int16_t, MAX_CELLS> countdown;
+
+    /** The cells on fire. */
+    IndexList<MAX_CELLS> bdry;
+
+    /** The flammable cells next to the fire. */
+    IndexList<MAX_CELLS> outer_bdry;
+
+    /** Membership of the cells in outer_bdry. */
+    std::bitset<MAX_CELLS> in_outer_bdry;
+
+    /** Initialize the boundaries with `n' as the only cell on fire. */
+    void start_fire(size_t n);
+
+    void apply(const Move &move);
+    void expand_fire(size_t n);
+
+    bool is_ready() const { return cooldown == 0; }
+    bool is_terminal() const { return bdry.empty(); }
+    int current_value() const { return value; }
+    bool is_flammable(size_t ndx) const;
+    std::array<size_t, 4> offsets(size_t ndx) const;
+  };
+
+  using cell_iterator = const Cell*;
 
   void init_input(std::istream &is);
   void turn_input(std::istream &is);
 
   bool test_against_turn_input();
 
-  void apply(const Move &move);
-  unsigned int turn() const { return m_turn; }
-  bool is_ready() const { return m_cooldown == 0; }
-  bool is_terminal() const;
+  void apply(const Move &move) { m_state.apply(move); }
+  unsigned int turn() const { return m_state.turn; }
+  bool is_ready() const { return m_state.is_ready(); }
+  /** Whether the fire has burnt out. */
+  bool is_terminal() const { return m_state.is_terminal(); }
 
   std::string format_move(const Move& move);
 
-  const std::vector<size_t>& outer_bdry() const { return m_outer_bdry; }
-  void expand_fire(size_t n);
+  const IndexList<MAX_CELLS>& outer_bdry() const { return m_state.outer_bdry; }
+  void expand_fire(size_t n) { m_state.expand_fire(n); }
 
   size_t width() const { return m_width; }
   size_t height() const { return m_height; }
@@ -56,21 +136,22 @@ public:
     unsigned int value_tree() const { return Tree.Value; }
     unsigned int value_house() const { return House.Value; }
 
-  std::array<size_t, 4> offsets(size_t ndx) const;
+  std::array<size_t, 4> offsets(size_t ndx) const { return m_state.offsets(ndx); }
 
   int duration_cut(size_t ndx) const;
   int duration_fire(size_t ndx) const;
-  bool is_flammable(size_t ndx) const;
+  bool is_flammable(size_t ndx) const { return m_state.is_flammable(ndx); }
 
   const std::vector<int>& fire_progress() { return m_fire_progress; };
-  int current_value() const;
-  const Cell& cell(size_t ndx) const { return m_cells[ndx]; }
-  cell_iterator cells_begin() const { return m_cells.begin(); }
-  cell_iterator cells_end() const { return m_cells.end(); }
+  int current_value() const { return m_state.current_value(); }
+  const Cell& cell(size_t ndx) const { return m_state.cells[ndx]; }
+  cell_iterator cells_begin() const { return m_state.cells.data(); }
+  cell_iterator cells_end() const { return m_state.cells.data() + size(); }
 
-  int value(size_t ndx) const { return m_cells[ndx].value(); }
+  int value(size_t ndx) const { return m_state.cells[ndx].value(); }
 
-  void get_bdry();
+  /** The state to clone for simulating the rest of the game. */
+  const State& state() const { return m_state; }
 
   friend class Agent;
 
@@ -78,23 +159,21 @@ private:
   size_t m_width;
   size_t m_height;
   Point m_fire_origin;
-  int m_cooldown;
-  size_t m_turn;
-  std::vector<Cell> m_cells;
+  State m_state;
   std::vector<int> m_fire_progress;
-  std::vector<size_t> m_bdry;
-  std::vector<size_t> m_outer_bdry;
 
 };
 
+static_assert(std::is_trivially_copyable_v<Game::State>);
+
 
-inline std::array<size_t, 4> Game::offsets(size_t n) const {
-  return {n - m_width, n - 1, n + 1, n + m_width};
+inline std::array<size_t, 4> Game::State::offsets(size_t n) const {
+  return {n - width, n - 1, n + 1, n + width};
 }
 
-inline bool Game::is_flammable(size_t ndx) const {
-  return m_cells[ndx].type() != Cell::Type::Safe
-    && m_cells[ndx].status() == Cell::Status::NoFire;
+inline bool Game::State::is_flammable(size_t ndx) const {
+  return cells[ndx].type() != Cell::Type::Safe
+    && cells[ndx].status() == Cell::Status::NoFire;
 }
 
 
@@ -0,0 +1,361 @@
+#include "search.h"
+#include "agent.h"
+#include "firebreak.h"
+#include "game.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** Time allowed for planning, within the first turn's limit. */
+constexpr auto time_budget = std::chrono::milliseconds(800);
+
+/** Number of nodes kept at each depth of the beam. */
+constexpr size_t beam_width = 16;
+
+/** Number of cuts tried from each node of the beam. */
+constexpr size_t n_candidates = 12;
+
+/**
+ * Fixed pool of worker threads running batches of
+ * independent jobs.
+ */
+class ThreadPool {
+public:
+  explicit ThreadPool(unsigned n_threads) {
+    for (unsigned i = 0; i < n_threads; ++i) {
+      m_threads.emplace_back([this]{ work(); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard lock{m_mutex};
+      m_quit = true;
+    }
+    m_start.notify_all();
+    for (auto& t : m_threads) { t.join(); }
+  }
+
+  /** Call job(0), ..., job(n_jobs - 1) and wait for all of them. */
+  void run(size_t n_jobs, std::function<void(size_t)> job) {
+    std::unique_lock lock{m_mutex};
+    m_job = std::move(job);
+    m_n_jobs = n_jobs;
+    m_next = 0;
+    m_active = m_threads.size();
+    ++m_generation;
+    m_start.notify_all();
+    m_done.wait(lock, [this]{ return m_active == 0; });
+  }
+
+private:
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_start;
+  std::condition_variable m_done;
+  std::function<void(size_t)> m_job;
+  size_t m_n_jobs = 0;
+  std::atomic<size_t> m_next{0};
+  size_t m_active = 0;
+  unsigned m_generation = 0;
+  bool m_quit = false;
+
+  void work() {
+    unsigned seen = 0;
+    while (true) {
+      {
+        std::unique_lock lock{m_mutex};
+        m_start.wait(lock, [&]{ return m_quit || m_generation != seen; });
+        if (m_quit) { return; }
+        seen = m_generation;
+      }
+
+      for (size_t i = m_next++; i < m_n_jobs; i = m_next++) {
+        m_job(i);
+      }
+
+      std::lock_guard lock{m_mutex};
+      if (--m_active == 0) { m_done.notify_one(); }
+    }
+  }
+};
+
+/** Marks the root in the links between nodes. */
+constexpr size_t NO_PARENT = -1;
+
+/** The last cut of a sequence, pointing back to the rest of it. */
+struct Link {
+  /** Index of the parent's link, at the previous depth */
+  size_t parent;
+  size_t cut;
+};
+
+/** A sequence of cuts, the state right after it is in the beam's arena. */
+struct Node {
+  /** Index of the node's link, at its depth */
+  size_t link;
+  /** Hash of the set of cut cells, merging permutations */
+  uint64_t key;
+  /** Value of the game if no more cells are cut */
+  int value;
+};
+
+/** Start of the planning turn */
+Clock::time_point start_time;
+
+/** Distances of the fire from its origin, see Agent::generate_distance_map */
+const std::vector<int>* distances = nullptr;
+
+/** The cuts of the minimum cut solution, see firebreak::plan */
+std::vector<size_t> firebreak_cuts;
+
+/** Size of the thread pool, 0 for the number of cores. */
+unsigned pool_size = 0;
+
+uint64_t cut_key(size_t n) {
+  // splitmix64 finalizer
+  uint64_t z = n + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+/** Wait until the next cut can be given. */
+void advance(Game::State &state) {
+  while (not state.is_ready() && not state.is_terminal()) {
+    state.apply(WAIT);
+  }
+}
+
+/** Final value of the game if no more cells are cut. */
+int rollout(const Game::State &state) {
+  thread_local Game::State buf;
+  buf = state;
+  while (not buf.is_terminal()) {
+    buf.apply(WAIT);
+  }
+  return buf.current_value();
+}
+
+/**
+ * Final value of the game when giving the cuts in order, skipping
+ * those which are not possible anymore.
+ *
+ * @param played  Set to the cuts actually given.
+ */
+int play(Game::State state, const std::vector<size_t> &cuts, std::vector<Move> &played) {
+  played.clear();
+  for (size_t c : cuts) {
+    advance(state);
+    if (state.is_terminal()) {
+      break;
+    }
+    if (state.is_flammable(c)) {
+      played.push_back(Move{ Move::Type::Cut, c });
+      state.apply(played.back());
+    }
+  }
+  return rollout(state);
+}
+
+/**
+ * The cells the fire can still reach, closest to the fire first.
+ *
+ * The next cell of the minimum cut solution comes first, then cells
+ * are ordered by the number of steps from the burning cells and by
+ * the fire's distance map.
+ */
+std::vector<size_t> candidates(const Game::State &state) {
+  std::vector<size_t> ret;
+
+  auto next_cut = std::find_if(firebreak_cuts.begin(), firebreak_cuts.end(),
+                               [&](size_t c) { return state.is_flammable(c); });
+  if (next_cut != firebreak_cuts.end()) {
+    ret.push_back(*next_cut);
+  }
+  std::vector<size_t> layer, next;
+  std::vector<char> seen(state.size, 0);
+
+  for (size_t n : state.bdry) {
+    layer.push_back(n);
+    seen[n] = 1;
+  }
+
+  while (not layer.empty() && ret.size() < n_candidates) {
+    next.clear();
+    for (size_t n : layer) {
+      for (size_t o : state.offsets(n)) {
+        if (not seen[o] && state.is_flammable(o)) {
+          seen[o] = 1;
+          next.push_back(o);
+        }
+      }
+    }
+    if (distances) {
+      std::sort(next.begin(), next.end(), [](size_t a, size_t b){
+        return (*distances)[a] < (*distances)[b];
+      });
+    }
+    for (size_t n : next) {
+      if (ret.size() == n_candidates) { break; }
+      if (next_cut != firebreak_cuts.end() && n == *next_cut) { continue; }
+      ret.push_back(n);
+    }
+    std::swap(layer, next);
+  }
+  return ret;
+}
+
+ThreadPool& pool() {
+  static ThreadPool instance{
+    std::max(1u, pool_size > 0 ? pool_size : std::thread::hardware_concurrency())};
+  return instance;
+}
+
+}  // namespace
+
+
+namespace search {
+
+void set_n_threads(unsigned n_threads) { pool_size = n_threads; }
+
+void init(const Game &game, Agent &agent) {
+  start_time = Clock::now();
+  agent.generate_distance_map();
+  distances = &agent.get_distance_map();
+  firebreak_cuts = firebreak::plan(game, *distances);
+}
+
+std::vector<Move> get_moves(const Game &game) {
+  const auto deadline = start_time + time_budget;
+
+  // The states of the beam's nodes and of their children, only
+  // ever copied around once allocated
+  std::vector<Game::State> states(beam_width, game.state());
+  std::vector<Game::State> child_states;
+
+  advance(states[0]);
+  std::vector<Node> beam{ Node{NO_PARENT, 0, rollout(states[0])} };
+  const int beam_root_value = beam[0].value;
+
+  // history[d] holds the links of the nodes at depth d + 1
+  std::vector<std::vector<Link>> history;
+  std::pair<int, size_t> best{0, NO_PARENT};
+  int best_value = beam[0].value;
+
+  // The minimum cut solution as it is, when better than the beam's
+  std::vector<Move> firebreak_moves;
+  const int firebreak_value = play(game.state(), firebreak_cuts, firebreak_moves);
+  if (firebreak_value > best_value) {
+    best_value = firebreak_value;
+  }
+
+  std::vector<std::pair<size_t, size_t>> jobs;
+  std::vector<Node> children;
+  size_t n_rollouts = 0;
+  int depth = 0;
+
+  while (not beam.empty() && Clock::now() < deadline) {
+    jobs.clear();
+    for (size_t i = 0; i < beam.size(); ++i) {
+      if (states[i].is_terminal()) { continue; }
+      for (size_t c : candidates(states[i])) {
+        jobs.emplace_back(i, c);
+      }
+    }
+
+    if (child_states.size() < jobs.size()) {
+      child_states.resize(jobs.size());
+    }
+    children.assign(jobs.size(), Node{NO_PARENT, 0, -1});
+
+    pool().run(jobs.size(), [&](size_t j) {
+      if (Clock::now() >= deadline) { return; }
+
+      const auto [parent, c] = jobs[j];
+      Game::State& state = child_states[j];
+
+      state = states[parent];
+      state.apply(Move{ Move::Type::Cut, c });
+      advance(state);
+
+      children[j] = Node{j, beam[parent].key ^ cut_key(c), rollout(state)};
+    });
+
+    // Keep the best children, only once per set of cut cells
+    std::vector<Node> next;
+    for (const auto& child : children) {
+      if (child.link != NO_PARENT) {
+        ++n_rollouts;
+        next.push_back(child);
+      }
+    }
+    std::stable_sort(next.begin(), next.end(), [](const Node &a, const Node &b){
+      return a.value > b.value;
+    });
+
+    std::vector<size_t> parent_links;
+    for (const auto& node : beam) {
+      parent_links.push_back(node.link);
+    }
+
+    std::vector<Link>& links = history.emplace_back();
+    std::unordered_set<uint64_t> seen;
+    beam.clear();
+    for (auto& node : next) {
+      if (beam.size() == beam_width) { break; }
+      if (not seen.insert(node.key).second) { continue; }
+
+      const auto [parent, c] = jobs[node.link];
+      states[beam.size()] = child_states[node.link];
+      links.push_back(Link{parent_links[parent], c});
+      node.link = links.size() - 1;
+      beam.push_back(node);
+    }
+    ++depth;
+
+    if (not beam.empty() && beam.front().value > best_value) {
+      best_value = beam.front().value;
+      best = {depth, beam.front().link};
+    }
+  }
+
+  // Follow the links back from the best node
+  std::vector<Move> best_cuts;
+  for (auto [d, l] = best; d > 0; --d) {
+    best_cuts.push_back(Move{ Move::Type::Cut, history[d - 1][l].cut });
+    l = history[d - 1][l].parent;
+  }
+  std::reverse(best_cuts.begin(), best_cuts.end());
+
+  if (best.first == 0 && firebreak_value > beam_root_value) {
+    best_cuts = firebreak_moves;
+  }
+
+  std::cerr << "search: depth " << depth
+            << " rollouts " << n_rollouts
+            << " value " << best_value
+            << " (min cut " << firebreak_value << ")"
+            << " cuts " << best_cuts.size()
+            << " time " << std::chrono::duration_cast<std::chrono::milliseconds>(
+                 Clock::now() - start_time).count() << "ms"
+            << std::endl;
+
+  return best_cuts;
+}
+
+}  // namespace search
@@ -0,0 +1,50 @@
+/**
+ * Planning of the whole sequence of cuts at the start of the game.
+ */
+#ifndef SEARCH_H_
+#define SEARCH_H_
+
+#include "agent.h"
+#include "game.h"
+
+#include <vector>
+
+namespace search {
+
+/**
+ * Prepare the search for the given game, must be called
+ * right after the game's initialization input.
+ *
+ * @param game   Game in its initial state.
+ * @param agent  Agent of that game, providing the distance map
+ *   used to order the candidate cuts.
+ */
+void init(const Game &game, Agent &agent);
+
+/**
+ * Number of threads searching, to be set before the first call to
+ * get_moves(). Defaults to 0, for the number of cores.
+ */
+void set_n_threads(unsigned n_threads);
+
+/**
+ * Beam search over the sequences of cuts.
+ *
+ * Every node of the beam is a copy of the game advanced to the
+ * turn at which the next cut can be given. It is scored by
+ * letting the fire burn out without cutting anymore and taking
+ * Game::current_value(). The rollouts of each depth are spread
+ * over a pool of threads until the time budget runs out.
+ *
+ * The cuts of the minimum cut solution (see firebreak.h) are
+ * tried first from every node, and played as they are when
+ * nothing better is found.
+ *
+ * @return The cuts to play in order, each one as soon as the
+ *   game is ready.
+ */
+std::vector<Move> get_moves(const Game &game);
+
+}  // namespace search
+
+#endif // SEARCH_H_
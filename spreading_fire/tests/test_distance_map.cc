@@ -0,0 +1,120 @@
+#include "game.h"
+#include "agent.h"
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+/**
+ * Compare the agent's distance map with the turns at which
+ * the cells catch fire when playing the game without cutting.
+ */
+bool check_distance_map(Game& game) {
+  Agent agent{game};
+  agent.generate_distance_map();
+  const auto& dists = agent.get_distance_map();
+  const auto& parents = agent.get_parent_distances();
+
+  std::vector<int> arrival(game.size(), Agent::Unreachable);
+  arrival[game.fire_origin()] = 0;
+
+  Game sim{game};
+  while (not sim.is_terminal()) {
+    sim.apply(WAIT);
+    for (size_t n = 0; n < sim.size(); ++n) {
+      if (sim.cell(n).status() != Cell::Status::NoFire
+          && sim.cell(n).type() != Cell::Type::Safe
+          && arrival[n] == Agent::Unreachable) {
+        arrival[n] = sim.turn();
+      }
+    }
+  }
+
+  bool okay = true;
+  for (size_t n = 0; n < game.size(); ++n) {
+    if (dists[n] != arrival[n]) {
+      auto [x, y] = game.coords(n);
+      std::cerr << "Cell " << x << ' ' << y << " has distance " << dists[n]
+                << " but catches fire at turn " << arrival[n] << std::endl;
+      okay = false;
+    }
+    if (not game.is_flammable(n)) {
+      continue;
+    }
+    // The distance through each parent is its arrival time plus its fire duration
+    const std::array<std::pair<Direction, size_t>, 4> nbhs{{
+        {WEST, n + 1}, {EAST, n - 1}, {NORTH, n + game.width()}, {SOUTH, n - game.width()}
+      }};
+    for (auto [d, p] : nbhs) {
+      int expected = arrival[p] == Agent::Unreachable
+        ? Agent::Unreachable
+        : arrival[p] + game.duration_fire(p);
+      if (parents[n][d] != expected) {
+        auto [x, y] = game.coords(n);
+        std::cerr << "Cell " << x << ' ' << y << " has parent distance " << parents[n][d]
+                  << " in direction " << d << " instead of " << expected << std::endl;
+        okay = false;
+      }
+    }
+  }
+  return okay;
+}
+
+/** Input for a random map surrounded by safe cells. */
+std::string random_input(std::mt19937& eng) {
+  std::uniform_int_distribution<int> duration(1, 6);
+  std::uniform_int_distribution<int> side(4, 50);
+  std::uniform_int_distribution<int> type(0, 9);
+
+  const int width = side(eng);
+  const int height = side(eng);
+  const int x0 = std::uniform_int_distribution<int>(1, width - 2)(eng);
+  const int y0 = std::uniform_int_distribution<int>(1, height - 2)(eng);
+
+  std::ostringstream os;
+  os << duration(eng) << ' ' << duration(eng) << " 1\n"
+     << duration(eng) << ' ' << duration(eng) << " 10\n"
+     << width << ' ' << height << '\n'
+     << x0 << ' ' << y0 << '\n';
+
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const bool border = x == 0 || y == 0 || x == width - 1 || y == height - 1;
+      const int t = type(eng);
+      os << (border ? '#' : x == x0 && y == y0 ? '.' : t < 2 ? '#' : t < 3 ? 'X' : '.');
+    }
+    os << '\n';
+  }
+  return os.str();
+}
+
+int main(int argc, char *argv[]) {
+
+  std::ifstream ifs { TEST_DATA_DIR "/input1.txt" };
+
+  if (not ifs) {
+    std::cerr << "Failed to open input file" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  Game game{};
+  game.init_input(ifs);
+
+  bool okay = check_distance_map(game);
+
+  std::mt19937 eng{ 42 };
+  for (int i = 0; i < 100; ++i) {
+    std::istringstream is{ random_input(eng) };
+    Game random_game{};
+    random_game.init_input(is);
+    okay = check_distance_map(random_game) && okay;
+  }
+
+  if (not okay) {
+    std::cerr << "FAILED" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+#include "game.h"
+#include "agent.h"
+#include "firebreak.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+/** Reference maximum flow, with BFS augmenting paths on a capacity matrix. */
+int64_t edmonds_karp(std::vector<std::vector<int64_t>> cap, size_t s, size_t t) {
+  const size_t n = cap.size();
+  int64_t flow = 0;
+  while (true) {
+    std::vector<size_t> parent(n, n);
+    std::vector<size_t> queue{s};
+    parent[s] = s;
+    for (size_t i = 0; i < queue.size() && parent[t] == n; ++i) {
+      for (size_t v = 0; v < n; ++v) {
+        if (parent[v] == n && cap[queue[i]][v] > 0) {
+          parent[v] = queue[i];
+          queue.push_back(v);
+        }
+      }
+    }
+    if (parent[t] == n) {
+      return flow;
+    }
+    int64_t delta = std::numeric_limits<int64_t>::max();
+    for (size_t v = t; v != s; v = parent[v]) {
+      delta = std::min(delta, cap[parent[v]][v]);
+    }
+    for (size_t v = t; v != s; v = parent[v]) {
+      cap[parent[v]][v] -= delta;
+      cap[v][parent[v]] += delta;
+    }
+    flow += delta;
+  }
+}
+
+bool test_max_flow() {
+  std::mt19937 eng{ 42 };
+  bool okay = true;
+
+  for (int i = 0; i < 200; ++i) {
+    const size_t n = std::uniform_int_distribution<size_t>(2, 12)(eng);
+    std::uniform_int_distribution<size_t> node(0, n - 1);
+    std::uniform_int_distribution<int64_t> capacity(0, 20);
+
+    firebreak::MaxFlow flow{n};
+    std::vector<std::vector<int64_t>> cap(n, std::vector<int64_t>(n, 0));
+
+    for (size_t e = 0; e < 3 * n; ++e) {
+      size_t u = node(eng), v = node(eng);
+      if (u == v) { continue; }
+      int64_t c = capacity(eng);
+      flow.add_edge(u, v, c);
+      cap[u][v] += c;
+    }
+
+    const int64_t value = flow.run(0, n - 1);
+    const int64_t expected = edmonds_karp(cap, 0, n - 1);
+
+    // The capacity of the cut found must be the flow's value
+    int64_t cut = 0;
+    for (size_t u = 0; u < n; ++u)
+      for (size_t v = 0; v < n; ++v)
+        if (flow.source_side(u) && not flow.source_side(v)) {
+          cut += cap[u][v];
+        }
+
+    if (value != expected || cut != expected || not flow.source_side(0) || flow.source_side(n - 1)) {
+      std::cerr << "Graph " << i << ": flow " << value << " cut " << cut
+                << " instead of " << expected << std::endl;
+      okay = false;
+    }
+  }
+  return okay;
+}
+
+bool test_plan() {
+  std::ifstream ifs { TEST_DATA_DIR "/input1.txt" };
+  if (not ifs) {
+    std::cerr << "Failed to open input file" << std::endl;
+    return false;
+  }
+  Game game{};
+  game.init_input(ifs);
+
+  Agent agent{game};
+  agent.generate_distance_map();
+  std::vector<size_t> cuts = firebreak::plan(game, agent.get_distance_map());
+
+  Game idle{game};
+  while (not idle.is_terminal()) {
+    idle.apply(WAIT);
+  }
+
+  // Every cut must be possible when its turn comes
+  size_t m = 0;
+  while (not game.is_terminal()) {
+    Move move = m < cuts.size() && game.is_ready() ? Move{ Move::Type::Cut, cuts[m++] } : WAIT;
+    if (move.type == Move::Type::Cut && not game.is_flammable(move.index)) {
+      std::cerr << "Cut " << game.format_move(move) << " is too late" << std::endl;
+      return false;
+    }
+    game.apply(move);
+  }
+
+  std::cerr << "Min cut plan: " << cuts.size() << " cuts, value " << game.current_value()
+            << " (without cutting: " << idle.current_value() << ")" << std::endl;
+
+  return m == cuts.size() && game.current_value() > idle.current_value();
+}
+
+int main(int argc, char *argv[]) {
+  bool okay = test_max_flow();
+  okay = test_plan() && okay;
+
+  if (not okay) {
+    std::cerr << "FAILED" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,53 @@
+#include "game.h"
+#include "agent.h"
+#include "search.h"
+
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char *argv[]) {
+
+  std::ifstream ifs { TEST_DATA_DIR "/input1.txt" };
+
+  if (not ifs) {
+    std::cerr << "Failed to open input file" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  Game game{};
+  game.init_input(ifs);
+  std::cerr << "Initialized Game" << std::endl;
+
+  // Value when letting the fire burn everything it can reach
+  Game idle{game};
+  while (not idle.is_terminal()) {
+    idle.apply(WAIT);
+  }
+
+  Agent agent{game};
+  search::init(game, agent);
+  std::vector<Move> moves = search::get_moves(game);
+  std::cerr << "Got " << moves.size() << " moves" << std::endl;
+
+  // Play the plan the same way main.cpp does
+  size_t m = 0;
+  while (not game.is_terminal()) {
+    Move move = m < moves.size() && game.is_ready() ? moves[m++] : WAIT;
+
+    if (move.type == Move::Type::Cut && not game.is_flammable(move.index)) {
+      std::cerr << "Invalid cut " << game.format_move(move) << std::endl;
+      return EXIT_FAILURE;
+    }
+    game.apply(move);
+  }
+
+  std::cerr << "Value " << game.current_value()
+            << " (without cutting: " << idle.current_value() << ")" << std::endl;
+
+  if (m != moves.size() || game.current_value() <= idle.current_value()) {
+    std::cerr << "FAILED" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -3,8 +3,12 @@
 
 #include "types.h"
 #include "game.h"
+#include "spatial.h"
+#include "planner.h"
 
 #include <algorithm>
+#include <chrono>
+#include <optional>
 #include <vector>
 
 namespace spring {
@@ -16,10 +20,10 @@ struct MonsterData
     Monster monster;
     /* Record the closest hero */
     unsigned int closest_hero{3};
-    /* Record the distance to closest hero */
-    double dist_closest_hero{std::numeric_limits<double>::max()};
-    /* Record distance to base */
-    double dist_base{std::numeric_limits<double>::max()};
+    /* Record the squared distance to closest hero */
+    int d2_closest_hero{std::numeric_limits<int>::max()};
+    /* Record squared distance to base */
+    int d2_base{std::numeric_limits<int>::max()};
     /* Number of turns until it does damage, or -1 if never */
     int n_turns_until_damage{-1};
 };
@@ -41,31 +45,38 @@ public:
     }
 
     /**
-     * Pointer to monster that is closest to hero with id
+     * Pointer to the closest monster to hero among those closer to it than to the other heros,
+     * nullptr if there is none
      */
-    [[nodiscard]] auto closest_to_hero(unsigned int hero_id) const -> const MonsterData* {
-        // The comparison functor
-        static auto cmp_closest = [id=hero_id](const auto& a, const auto& b) {
-            if (a.closest_hero == id) {
-                if (b.closest_hero == id) {
-                    return a.dist_closest_hero < b.dist_closest_hero;
-                }
-                else {
-                    return true;
-                }
-            }
-            else {
-                return false;
-            }
-        };
+    [[nodiscard]] auto closest_to_hero(const Hero& hero) const -> const MonsterData* {
+        const int i = m_grid.nearest(hero.pos, [this, id=hero.index()](int i) {
+            return m_data[i].closest_hero == (unsigned int)id;
+        });
+        return i == -1 ? nullptr : &m_data[i];
+    }
 
-        auto it = std::min_element(m_data.begin(), m_data.end(), cmp_closest);
+    /**
+     * Call f(data) for the monsters within radius of center
+     */
+    template<typename F>
+    void for_each_within(const Point& center, int radius, F&& f) const {
+        m_grid.for_each_within(center, radius, [&](int i) { f(m_data[i]); });
+    }
 
-        return it == m_data.end() ? nullptr : &*it;
+    /**
+     * Pointers to the k closest monsters to center, from the closest
+     */
+    void k_nearest(const Point& center, size_t k, std::vector<const MonsterData*>& out) const {
+        static thread_local std::vector<int> indices;
+        m_grid.k_nearest(center, k, indices);
+        out.clear();
+        for (int i : indices) {
+            out.push_back(&m_data[i]);
+        }
     }
 
     /**
-     * Sort the data with respect to the Cmp binary functor
+     * Sort the data with respect to the Cmp binary functor, and index it on the grid
      */
     template<typename Cmp>
     void sort(Cmp cmp) {
@@ -73,6 +84,7 @@ public:
         m_indices.resize(m_data.size());
         std::transform(m_data.begin(), m_data.end(), m_indices.begin(),
                        [](const auto& m) { return m.monster.id; });
+        m_grid.build(m_data, [](const auto& m) { return m.monster.pos; });
     }
 
     /**
@@ -101,6 +113,8 @@ private:
     std::vector<unsigned int> m_indices;
     /* The monster's data */
     std::vector<MonsterData> m_data;
+    /* The monsters' positions, bucketed by the range of CONTROL and SHIELD */
+    SpatialIndex m_grid{ 2200 };
 };
 
 /**
@@ -141,10 +155,17 @@ struct ActionFactory {
 class Agent
 {
 public:
-    Agent(Game& game)
+    /**
+     * The actions are chosen by the rules, then improved by the planner
+     * for `plan_budget' if it is not zero.
+     */
+    Agent(Game& game, std::chrono::milliseconds plan_budget = std::chrono::milliseconds{ 0 })
             : m_game{ game }
     {
         init();
+        if (plan_budget.count() > 0) {
+            m_planner.emplace(plan_budget);
+        }
     }
 
     void choose_actions(std::vector<Action>& actions)
@@ -157,16 +178,26 @@ public:
 
         std::cerr << "Updated Agent's data" << std::endl;
 
+        // The defenders have the priority on the mana, the actions are output by hero index
+        std::array<Action, 3> rules;
         for (auto i : {1, 2, 0}) {
             if (m_threats.is_empty()) {
-                actions.push_back(do_default(m_game.us().heros[i]));
+                rules[i] = do_default(m_game.us().heros[i]);
             }
-            else if (m_game.us().heros[i].id == 0) {
-                actions.push_back(do_push_or_move_closest(m_game.us().heros[i]));
+            else if (m_game.us().heros[i].index() == 0) {
+                rules[i] = do_push_or_move_closest(m_game.us().heros[i]);
             } else {
-                actions.push_back(do_defend_first(m_game.us().heros[i]));
+                rules[i] = do_defend_first(m_game.us().heros[i]);
             }
         }
+
+        if (!m_planner) {
+            actions.assign(rules.begin(), rules.end());
+            return;
+        }
+        m_planner->plan(m_game, rules, actions);
+        std::cerr << "Planner: " << m_planner->generations() << " generations, "
+                  << m_planner->generations_per_second() << " generations/s" << std::endl;
     }
 
 private:
@@ -183,12 +214,13 @@ private:
 
     int mana_used { 0 };
     ActionFactory af;
+    std::optional<Planner> m_planner;
 
     /**
      * Move hero towards its default target
      */
     auto do_default(const Hero& hero) -> Action {
-        return af.make_move(default_targets[hero.id], "No threats! --> default");
+        return af.make_move(default_targets[hero.index()], "No threats! --> default");
     }
 
     /**
@@ -196,7 +228,7 @@ private:
      */
     auto do_defend_first(const Hero& hero) -> Action {
         const MonsterData* closest_md = m_threats.closest_to_base();
-        if (m_game.us().mana - mana_used >= 10 && closest_md->dist_closest_hero < 1280.0) {
+        if (m_game.us().mana - mana_used >= 10 && closest_md->d2_closest_hero < 1280 * 1280) {
             mana_used += 10;
             return af.make_wind(hero.pos + closest_md->monster.pos, "Pushing threat out of base radius");
         }
@@ -208,22 +240,22 @@ private:
      */
     auto do_push_or_move_closest(const Hero& hero) -> Action {
 
-        const MonsterData* closest_md = m_threats.closest_to_hero(hero.id);
+        const MonsterData* closest_md = m_threats.closest_to_hero(hero);
 
         if (closest_md == nullptr) {
-            return af.make_move(default_targets[hero.id], "Closest threat is closer to another hero, moving to default");
+            return af.make_move(default_targets[hero.index()], "Closest threat is closer to another hero, moving to default");
         }
 
-        if (closest_md->dist_closest_hero < 1280.0) {
+        if (closest_md->d2_closest_hero < 1280 * 1280) {
             mana_used += 10;
             return af.make_wind((hero.pos + closest_md->monster.pos) + -m_origin, "Pushing towards opponent");
         }
-        else if (distance(closest_md->monster.pos, default_targets[0]) < 1280.0 + 1600.0) {
+        else if (distance2(closest_md->monster.pos, default_targets[0]) < (1280 + 1600) * (1280 + 1600)) {
             Point target = closest_md->monster.pos + closest_md->monster.vel;
             return af.make_move(target, "Catching target to push onto opponent");
         }
         else {
-            return af.make_move(default_targets[hero.id], "Closest threat is too far");
+            return af.make_move(default_targets[hero.index()], "Closest threat is too far");
         }
     }
 
@@ -259,7 +291,7 @@ private:
         }
 
         // Comparison functor for sorting w.r.t. distance to base
-        static auto cmp_dist_base = [](const auto& a, const auto& b) { return a.dist_base < b.dist_base; };
+        static auto cmp_dist_base = [](const auto& a, const auto& b) { return a.d2_base < b.d2_base; };
 
         // Sort by distance to base
         m_threats.sort(cmp_dist_base);
@@ -271,14 +303,13 @@ private:
 
         data.monster = m;
 
-        data.dist_base = distance(m_origin, m.pos);
-        std::array<double, 3> d2_mhs = { distance(m.pos, m_game.us().heros[0].pos),
-                                         distance(m.pos, m_game.us().heros[1].pos),
-                                         distance(m.pos, m_game.us().heros[2].pos) };
+        data.d2_base = distance2(m_origin, m.pos);
+        const auto heros = m_game.us().heros;
         for (int i=0; i<3; ++i) {
-            if (d2_mhs[i] < data.dist_closest_hero) {
+            const int d2 = distance2(m.pos, heros[i].pos);
+            if (d2 < data.d2_closest_hero) {
                 data.closest_hero = i;
-                data.dist_closest_hero = d2_mhs[i];
+                data.d2_closest_hero = d2;
             }
         }
 
@@ -287,7 +318,7 @@ private:
 
     // Aim at some monster
     auto target_monster(const Hero& h, const Monster& m) -> Point {
-        return m.pos + m.vel + (h.id == 1 ? Point{780, 0} : Point{0, 780});
+        return m.pos + m.vel + (h.index() == 1 ? Point{780, 0} : Point{0, 780});
     }
 };
 
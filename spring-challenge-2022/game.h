@@ -18,6 +18,11 @@ struct Hero
     Point pos;
     int shield_life;
     bool is_controlled;
+
+    /**
+     * Index of the hero among its player's, the second player's ids being 3 to 5
+     */
+    [[nodiscard]] constexpr auto index() const -> int { return id % 3; }
 };
 
 struct Player
@@ -152,8 +157,8 @@ public:
                 monster.shield_life = shield_life;
                 monster.is_controlled = (bool)is_controlled;
                 monster.health = health;
-                monster.vel.x = normalized_x(vx);
-                monster.vel.y = normalized_y(vy);
+                monster.vel.x = normalized_dx(vx);
+                monster.vel.y = normalized_dy(vy);
                 monster.near_base = (bool)near_base;
                 switch (threat_for) {
                     case 0:
@@ -188,6 +193,14 @@ public:
         return m_should_reflect ? y = HEIGHT - y - 1 : y;
     }
 
+    [[nodiscard]] auto normalized_dx(int dx) const -> int {
+        return m_should_reflect ? -dx : dx;
+    }
+
+    [[nodiscard]] auto normalized_dy(int dy) const -> int {
+        return m_should_reflect ? -dy : dy;
+    }
+
     auto normalize(Point& p) const -> Point& {
         p.x = normalized_x(p.x);
         p.y = normalized_y(p.y);
@@ -1,4 +1,5 @@
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <string_view>
 #include <vector>
@@ -62,7 +63,7 @@ main() -> int
     game.init(cin);
     game.update(cin);
 
-    Agent agent(game);
+    Agent agent(game, std::chrono::milliseconds{ 40 });
 
     std::vector<Action> actions;
 
@@ -0,0 +1,330 @@
+#ifndef PLANNER_H_
+#define PLANNER_H_
+
+#include "types.h"
+#include "game.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace spring {
+
+/**
+ * Rolling horizon evolutionary planner for the three heros.
+ *
+ * A plan is a short sequence of MOVE or WIND targets for each of the
+ * three heros, evolved jointly: every plan is played on the simulator
+ * of simulator.h from the current state against an opponent moving its
+ * heros to the monsters threatening its base, and valued by evaluate().
+ *
+ * The population is kept from one turn to the next, shifted by one turn,
+ * and one plan is seeded with the actions of the rule-based agent.
+ *
+ * The simulation is run in the frame of the Game, our base being at
+ * (0, 0), with our heros renumbered 0 to 2 and the opponent's 3 to 5.
+ */
+class Planner
+{
+public:
+    static constexpr int HORIZON = 3;
+    static constexpr int POPULATION = 16;
+
+    explicit Planner(std::chrono::milliseconds budget)
+            : m_budget{ budget }
+    {}
+
+    /**
+     * Evolve the plans until the budget is spent and set `actions' to the
+     * first actions of the best one.
+     *
+     * @param seed The actions of the rule-based agent, by hero index.
+     */
+    void plan(const Game& game, const std::array<Action, 3>& seed, std::vector<Action>& actions)
+    {
+        const auto start = Clock::now();
+        const auto deadline = start + m_budget;
+
+        set_root(game);
+        shift_population();
+        for (auto& ind : m_population) {
+            ind.value = evaluate(ind.genome);
+        }
+
+        // The seed replaces the worst plan, keeping the previous turn's best
+        auto& worst = *std::min_element(m_population.begin(), m_population.end(), by_value);
+        worst.genome = seeded_genome(seed);
+        worst.value = evaluate(worst.genome);
+        m_generations = 0;
+
+        while (Clock::now() < deadline) {
+            next_generation(deadline);
+            ++m_generations;
+        }
+
+        const auto& best = *std::max_element(m_population.begin(), m_population.end(), by_value);
+        actions.clear();
+        for (int h = 0; h < 3; ++h) {
+            actions.push_back(to_action(best.genome[0][h], "plan"));
+        }
+
+        m_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    /**
+     * Number of generations evolved during the last call to plan()
+     */
+    [[nodiscard]] auto generations() const -> int { return m_generations; }
+
+    /**
+     * Generations per second during the last call to plan()
+     */
+    [[nodiscard]] auto generations_per_second() const -> double
+    {
+        return m_seconds > 0 ? m_generations / m_seconds : 0.0;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Gene
+    {
+        bool wind;
+        Point target;
+    };
+    /* The genes of the heros for each turn of the horizon */
+    using Genome = std::array<std::array<Gene, 3>, HORIZON>;
+
+    struct Individual
+    {
+        Genome genome;
+        double value;
+    };
+
+    static constexpr Point their_base{ WIDTH - 1, HEIGHT - 1 };
+
+    std::chrono::milliseconds m_budget;
+    std::mt19937 m_eng{ 2022 };
+    sim::State m_root;
+    std::vector<Individual> m_population;
+    std::vector<Individual> m_next;
+    int m_generations{ 0 };
+    double m_seconds{ 0.0 };
+
+    static auto by_value(const Individual& a, const Individual& b) -> bool { return a.value < b.value; }
+
+    static auto to_action(const Gene& g, std::string_view msg = "") -> Action
+    {
+        return g.wind ? Action{ Spell::Type::WIND, g.target, -1, msg } : Action{ g.target, msg };
+    }
+
+    /**
+     * The simulator's state from the game, the unseen opponent heros waiting in their base
+     */
+    void set_root(const Game& game)
+    {
+        m_root.players = { game.us(), game.them() };
+        m_root.monsters = game.monsters();
+        m_root.control_targets.fill(Point_None);
+        m_root.turn = 0;
+
+        auto& them = m_root.players[1].heros;
+        them.resize(3, Hero{ 0, their_base, 0, false });
+        for (int p = 0; p < 2; ++p) {
+            for (int i = 0; i < 3; ++i) {
+                m_root.players[p].heros[i].id = 3 * p + i;
+            }
+        }
+    }
+
+    auto random_gene(int hero, int turn) -> Gene
+    {
+        std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+        const double a = angle(m_eng);
+        const double reach = MAX_MOVE * (turn + 1);
+        const Point& pos = m_root.players[0].heros[hero].pos;
+
+        Gene g;
+        g.wind = std::uniform_int_distribution<int>(0, 9)(m_eng) == 0;
+        if (g.wind && std::uniform_int_distribution<int>(0, 1)(m_eng) == 0) {
+            g.target = their_base;
+        } else {
+            g.target = sim::clamped_to_map({ pos.x + int(reach * std::cos(a)), pos.y + int(reach * std::sin(a)) });
+        }
+        return g;
+    }
+
+    /**
+     * A plan repeating the rule-based actions, waiting for the spells other than WIND
+     */
+    auto seeded_genome(const std::array<Action, 3>& seed) const -> Genome
+    {
+        Genome genome;
+        for (int h = 0; h < 3; ++h) {
+            const Action& a = seed[h];
+            const bool wind = a.type == Action::Type::SPELL && a.spell.type == Spell::Type::WIND;
+            const bool move = a.type == Action::Type::MOVE;
+            const Gene first{ wind, wind || move ? a.target : m_root.players[0].heros[h].pos };
+            for (int t = 0; t < HORIZON; ++t) {
+                genome[t][h] = first;
+                genome[t][h].wind = wind && t == 0;
+            }
+        }
+        return genome;
+    }
+
+    /**
+     * Drop the turn just played from every plan, completed by random genes
+     */
+    void shift_population()
+    {
+        if (m_population.empty()) {
+            m_population.resize(POPULATION);
+            for (auto& ind : m_population) {
+                for (int t = 0; t < HORIZON; ++t) {
+                    for (int h = 0; h < 3; ++h) {
+                        ind.genome[t][h] = random_gene(h, t);
+                    }
+                }
+            }
+            return;
+        }
+        for (auto& ind : m_population) {
+            std::rotate(ind.genome.begin(), ind.genome.begin() + 1, ind.genome.end());
+            for (int h = 0; h < 3; ++h) {
+                ind.genome[HORIZON - 1][h] = random_gene(h, HORIZON - 1);
+            }
+        }
+    }
+
+    /**
+     * Keep the best plan, breed the others from binary tournaments with a
+     * uniform crossover of the heros' turns and mutate one gene of each
+     */
+    void next_generation(Clock::time_point deadline)
+    {
+        std::uniform_int_distribution<int> pick(0, POPULATION - 1);
+        std::uniform_int_distribution<int> coin(0, 1);
+        auto tournament = [&]() -> const Individual& {
+            const Individual& a = m_population[pick(m_eng)];
+            const Individual& b = m_population[pick(m_eng)];
+            return a.value > b.value ? a : b;
+        };
+
+        m_next.clear();
+        m_next.push_back(*std::max_element(m_population.begin(), m_population.end(), by_value));
+
+        while (m_next.size() < POPULATION && Clock::now() < deadline) {
+            const Individual& a = tournament();
+            const Individual& b = tournament();
+            Individual child;
+            for (int t = 0; t < HORIZON; ++t) {
+                for (int h = 0; h < 3; ++h) {
+                    child.genome[t][h] = coin(m_eng) ? a.genome[t][h] : b.genome[t][h];
+                }
+            }
+            const int t = std::uniform_int_distribution<int>(0, HORIZON - 1)(m_eng);
+            const int h = std::uniform_int_distribution<int>(0, 2)(m_eng);
+            child.genome[t][h] = random_gene(h, t);
+            child.value = evaluate(child.genome);
+            m_next.push_back(child);
+        }
+
+        // An interrupted generation keeps the best of the previous one
+        if (m_next.size() < POPULATION) {
+            std::sort(m_population.begin(), m_population.end(), by_value);
+            std::copy(m_next.begin(), m_next.end(), m_population.end() - m_next.size());
+            return;
+        }
+        std::swap(m_population, m_next);
+    }
+
+    /**
+     * The opponent moves each hero to the monster closest to its base among those around it
+     */
+    static auto opponent_actions(const sim::State& s) -> std::array<Action, 3>
+    {
+        std::array<Action, 3> actions;
+        for (int h = 0; h < 3; ++h) {
+            const Point& pos = s.players[1].heros[h].pos;
+            const Monster* target = nullptr;
+            int best = std::numeric_limits<int>::max();
+            for (const auto& m : s.monsters) {
+                const int d2 = distance2(m.pos, their_base);
+                if (d2 < best && sim::in_range(m.pos, pos, sim::BASE_VISION)) {
+                    best = d2;
+                    target = &m;
+                }
+            }
+            if (target != nullptr) {
+                actions[h] = Action{ target->pos + target->vel };
+            }
+        }
+        return actions;
+    }
+
+    /**
+     * Value of the state for us: the bases' health, our mana, the monsters
+     * bound for each base, and how close our heros are to those bound for
+     * ours, or to our base if there is none.
+     */
+    static auto evaluate(const sim::State& s) -> double
+    {
+        const Player& us = s.players[0];
+        const Player& them = s.players[1];
+        constexpr Point our_base{ 0, 0 };
+        constexpr double guard_radius = 6000.0;
+
+        double value = 1000.0 * (us.health - them.health) + 2.0 * us.mana;
+
+        static thread_local std::vector<Point> threats;
+        threats.clear();
+        for (const auto& m : s.monsters) {
+            const int threat = sim::threat_of(m);
+            if (threat == 0) {
+                value -= (m.health + 10) * (WIDTH - distance(m.pos, our_base)) / 1000.0;
+                threats.push_back(m.pos);
+            } else if (threat == 1) {
+                value += 0.5 * m.health * (WIDTH - distance(m.pos, their_base)) / 1000.0;
+            }
+        }
+
+        for (const auto& hero : us.heros) {
+            if (threats.empty()) {
+                value -= std::max(distance(hero.pos, our_base) - guard_radius, 0.0) / 100.0;
+                continue;
+            }
+            int closest = std::numeric_limits<int>::max();
+            for (const auto& p : threats) {
+                closest = std::min(closest, distance2(hero.pos, p));
+            }
+            value -= std::sqrt(closest) / 100.0;
+        }
+
+        return value;
+    }
+
+    auto evaluate(const Genome& genome) const -> double
+    {
+        sim::State s = m_root;
+        sim::Actions actions;
+        for (int t = 0; t < HORIZON && !sim::is_over(s); ++t) {
+            for (int h = 0; h < 3; ++h) {
+                actions[0][h] = to_action(genome[t][h]);
+            }
+            actions[1] = opponent_actions(s);
+            sim::step(s, actions);
+        }
+        return evaluate(s);
+    }
+};
+
+} // namespace spring
+
+#endif // PLANNER_H_
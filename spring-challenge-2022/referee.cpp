@@ -0,0 +1,297 @@
+/**
+ * Local referee and batch self-play.
+ *
+ * Usage: referee [n_games [n_jobs [first_seed]]]
+ *
+ * Plays `n_games' games (default 20) of the agent with its planner
+ * against the agent with the rules only, on the simulator of simulator.h,
+ * each seed giving the monsters' spawns and the planner's side.
+ * The bots read the same input as on CodinGame, fog of war included,
+ * and their actions are taken as main.cpp outputs them.
+ *
+ * The games run `n_jobs' at a time (default: number of cores) in
+ * separate processes, keeping the agents' debug output away.
+ *
+ * NOTE: The spawns only approximate the official ones: a mirrored pair
+ * of monsters enters from the top and bottom edges every other turn,
+ * their health growing with the turns.
+ */
+#include "types.h"
+#include "game.h"
+#include "agent.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace spring;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int SPAWN_PERIOD = 2;
+constexpr int PLAN_BUDGET_MS = 40;
+
+struct Result
+{
+    int winner;
+    std::array<int, 2> health;
+    std::array<int, 2> wild_mana;
+    int turns;
+    int planner;
+};
+
+/**
+ * Plays as main.cpp does: the Game parses the input, the Agent
+ * chooses the actions and their targets are put back in the map's
+ * coordinates.
+ */
+template<int PlanBudgetMs>
+struct AgentBot
+{
+    Game game;
+    std::optional<Agent> agent;
+
+    void init(std::istream& input) { game.init(input); }
+
+    void play(std::istream& input, std::array<Action, 3>& out)
+    {
+        game.update(input);
+        if (!agent) {
+            agent.emplace(game, std::chrono::milliseconds{ PlanBudgetMs });
+        }
+        std::vector<Action> actions;
+        agent->choose_actions(actions);
+        for (int i = 0; i < 3; ++i) {
+            game.normalize(actions[i].target);
+            out[i] = actions[i];
+        }
+    }
+};
+
+using RulesBot = AgentBot<0>;
+using PlannerBot = AgentBot<PLAN_BUDGET_MS>;
+
+/**
+ * Add a mirrored pair of monsters on the top and bottom edges.
+ */
+void
+spawn_monsters(sim::State& s, std::mt19937& eng)
+{
+    std::uniform_real_distribution<double> angle(MM_PI_12, MM_5PI_12);
+    std::bernoulli_distribution coin;
+
+    const double a = angle(eng);
+    const int sign = coin(eng) ? 1 : -1;
+
+    Monster monster{};
+    monster.pos = { WIDTH / 2 + sign * (coin(eng) ? 4000 : 0), 0 };
+    monster.vel = { int(std::trunc(-sign * sim::MONSTER_SPEED * std::cos(a))),
+                    int(std::trunc(sim::MONSTER_SPEED * std::sin(a))) };
+    monster.health = 10 + 2 * (s.turn / 15);
+
+    monster.id = s.next_id++;
+    s.monsters.push_back(monster);
+
+    monster.id = s.next_id++;
+    monster.pos = { WIDTH - 1 - monster.pos.x, HEIGHT - 1 - monster.pos.y };
+    monster.vel = -monster.vel;
+    s.monsters.push_back(monster);
+}
+
+auto
+is_visible(const sim::State& s, int player, const Point& p) -> bool
+{
+    if (sim::in_range(p, sim::base_of(player), sim::BASE_VISION)) {
+        return true;
+    }
+    const auto& heros = s.players[player].heros;
+    return std::any_of(heros.begin(), heros.end(),
+                       [&p](const auto& h) { return sim::in_range(p, h.pos, sim::HERO_VISION); });
+}
+
+/**
+ * The turn's input of `player', in the format of the statement.
+ */
+void
+write_turn(std::ostream& out, const sim::State& s, int player)
+{
+    const Player& us = s.players[player];
+    const Player& them = s.players[1 - player];
+    std::ostringstream entities;
+    int n_entities = 0;
+
+    for (const auto& m : s.monsters) {
+        if (!is_visible(s, player, m.pos)) {
+            continue;
+        }
+        const int threat = sim::threat_of(m);
+        entities << m.id << " 0 " << m.pos.x << ' ' << m.pos.y << ' ' << m.shield_life << ' ' << m.is_controlled
+                 << ' ' << m.health << ' ' << m.vel.x << ' ' << m.vel.y << ' ' << m.near_base << ' '
+                 << (threat == -1 ? 0 : threat == player ? 1 : 2) << '\n';
+        ++n_entities;
+    }
+    for (int p : { player, 1 - player }) {
+        for (const auto& h : s.players[p].heros) {
+            if (p != player && !is_visible(s, player, h.pos)) {
+                continue;
+            }
+            entities << h.id << ' ' << (p == player ? 1 : 2) << ' ' << h.pos.x << ' ' << h.pos.y << ' '
+                     << h.shield_life << ' ' << h.is_controlled << " -1 -1 -1 -1 -1\n";
+            ++n_entities;
+        }
+    }
+
+    out << us.health << ' ' << us.mana << '\n'
+        << them.health << ' ' << them.mana << '\n'
+        << n_entities << '\n'
+        << entities.str();
+}
+
+template<typename Bot0, typename Bot1>
+auto
+play_game(uint32_t seed) -> Result
+{
+    std::mt19937 eng{ seed };
+    sim::State s = sim::initial_state();
+    Bot0 bot0;
+    Bot1 bot1;
+
+    for (int p : { 0, 1 }) {
+        std::stringstream ss;
+        ss << sim::base_of(p).x << ' ' << sim::base_of(p).y << "\n3\n";
+        p == 0 ? bot0.init(ss) : bot1.init(ss);
+    }
+
+    while (!sim::is_over(s)) {
+        if (s.turn % SPAWN_PERIOD == 0) {
+            spawn_monsters(s, eng);
+        }
+
+        sim::Actions actions;
+        for (int p : { 0, 1 }) {
+            std::stringstream ss;
+            write_turn(ss, s, p);
+            p == 0 ? bot0.play(ss, actions[0]) : bot1.play(ss, actions[1]);
+        }
+        sim::step(s, actions);
+    }
+
+    return { sim::winner(s),
+             { s.players[0].health, s.players[1].health },
+             s.wild_mana,
+             s.turn,
+             -1 };
+}
+
+/**
+ * Run the game in a child process, whose result can be read from the returned descriptor.
+ */
+auto
+spawn(uint32_t seed) -> std::pair<pid_t, int>
+{
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return { -1, -1 };
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        std::freopen("/dev/null", "w", stderr);
+
+        // The planner plays first on the odd seeds
+        Result res = seed % 2 ? play_game<PlannerBot, RulesBot>(seed) : play_game<RulesBot, PlannerBot>(seed);
+        res.planner = seed % 2 ? 0 : 1;
+        bool okay = write(fds[1], &res, sizeof(res)) == sizeof(res);
+        close(fds[1]);
+        _exit(okay ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    close(fds[1]);
+    return { pid, fds[0] };
+}
+
+} // namespace
+
+auto
+main(int argc, char* argv[]) -> int
+{
+    const int n_games = argc > 1 ? std::stoi(argv[1]) : 20;
+    const unsigned int n_jobs = argc > 2 && std::stoi(argv[2]) > 0 ? std::stoi(argv[2])
+                                                                   : std::max(1u, std::thread::hardware_concurrency());
+    const uint32_t first_seed = argc > 3 ? std::stoul(argv[3]) : 1;
+
+    std::vector<Result> results(n_games);
+    std::vector<bool> done(n_games, false);
+    std::vector<std::pair<pid_t, int>> running(n_games, { -1, -1 });
+    int next = 0;
+    unsigned int n_running = 0;
+
+    const auto start = Clock::now();
+
+    while (next < n_games || n_running > 0) {
+        while (next < n_games && n_running < n_jobs) {
+            running[next] = spawn(first_seed + next);
+            ++next;
+            ++n_running;
+        }
+
+        int status;
+        pid_t pid = wait(&status);
+        if (pid < 0) {
+            break;
+        }
+        for (int g = 0; g < next; ++g) {
+            if (running[g].first == pid) {
+                done[g] = read(running[g].second, &results[g], sizeof(Result)) == sizeof(Result);
+                close(running[g].second);
+                --n_running;
+            }
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << std::setw(8) << "seed" << std::setw(8) << "winner" << std::setw(10) << "health"
+              << std::setw(12) << "wild mana" << std::setw(7) << "turns" << std::setw(9) << "planner" << '\n';
+
+    std::array<int, 3> wins{ 0, 0, 0 };
+    int planner_wins = 0;
+    double sum_turns = 0;
+    for (int g = 0; g < n_games; ++g) {
+        std::cout << std::setw(8) << first_seed + g;
+        if (!done[g]) {
+            std::cout << "  FAILED\n";
+            continue;
+        }
+        const Result& r = results[g];
+        std::cout << std::setw(8) << (r.winner == -1 ? "draw" : r.winner == 0 ? "0" : "1")
+                  << std::setw(10) << (std::to_string(r.health[0]) + " - " + std::to_string(r.health[1]))
+                  << std::setw(12) << (std::to_string(r.wild_mana[0]) + " - " + std::to_string(r.wild_mana[1]))
+                  << std::setw(7) << r.turns << std::setw(9) << r.planner << '\n';
+        ++wins[r.winner + 1];
+        planner_wins += r.winner == r.planner;
+        sum_turns += r.turns;
+    }
+
+    std::cout << "\nwins " << wins[1] << " - " << wins[2] << ", draws " << wins[0] << ", planner "
+              << planner_wins << " - rules " << wins[1] + wins[2] - planner_wins << ", mean turns "
+              << std::fixed << std::setprecision(1) << sum_turns / n_games << ", " << n_games / seconds
+              << " games/s" << std::endl;
+
+    return std::all_of(done.begin(), done.end(), [](bool d) { return d; }) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,385 @@
+#ifndef SIMULATOR_H_
+#define SIMULATOR_H_
+
+#include "types.h"
+#include "game.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace spring::sim {
+
+constexpr int BASE_RADIUS = 5000;
+constexpr int BASE_DAMAGE_RADIUS = 300;
+constexpr int BASE_VISION = 6000;
+constexpr int HERO_VISION = 2200;
+constexpr int HERO_ATTACK_RADIUS = 800;
+constexpr int HERO_DAMAGE = 2;
+constexpr int MONSTER_SPEED = 400;
+constexpr int WIND_PUSH = 2200;
+constexpr int WIND_RANGE = Spell{ Spell::Type::WIND }.range();
+constexpr int SHIELD_DURATION = 12;
+constexpr int SPELL_COST = 10;
+
+/**
+ * The whole game seen by the referee.
+ *
+ * Unlike in Game, the coordinates are the map's own: the base of
+ * players[0] is at (0, 0) and the one of players[1] at the opposite
+ * corner. The heroes of players[0] have the ids 0 to 2, those of
+ * players[1] the ids 3 to 5.
+ */
+struct State
+{
+    std::array<Player, 2> players;
+    std::vector<Monster> monsters;
+    /* Mana gained outside of the player's base radius, for breaking ties */
+    std::array<int, 2> wild_mana{ 0, 0 };
+    /* Where the controlled heroes have to move on the next turn, by hero id */
+    std::array<Point, 6> control_targets;
+    int turn{ 0 };
+    int next_id{ 6 };
+};
+
+/**
+ * The actions of the three heroes of each player, in the order of their ids.
+ */
+using Actions = std::array<std::array<Action, 3>, 2>;
+
+inline auto constexpr
+base_of(int player) -> Point
+{
+    return player == 0 ? Point{ 0, 0 } : Point{ WIDTH - 1, HEIGHT - 1 };
+}
+
+inline auto constexpr
+in_range(const Point& a, const Point& b, int radius) -> bool
+{
+    return distance2(a, b) <= radius * radius;
+}
+
+inline auto constexpr
+is_inside_map(const Point& p) -> bool
+{
+    return p.x >= 0 && p.x < WIDTH && p.y >= 0 && p.y < HEIGHT;
+}
+
+inline auto constexpr
+clamped_to_map(const Point& p) -> Point
+{
+    return { std::clamp(p.x, 0, WIDTH - 1), std::clamp(p.y, 0, HEIGHT - 1) };
+}
+
+/**
+ * Move `from' by at most `max_dist' towards `to'.
+ *
+ * The new position is rounded with Vector::target(), like the
+ * positions computed with the `Point * double' operator.
+ */
+inline auto
+moved_towards(const Point& from, const Point& to, double max_dist) -> Point
+{
+    const Vector v = to - from;
+    const double d = std::sqrt(v.x * v.x + v.y * v.y);
+    if (d <= max_dist) {
+        return to;
+    }
+    return (v * (max_dist / d)).target();
+}
+
+/**
+ * The velocity of a monster heading from `from' to `to', truncated towards zero.
+ */
+inline auto
+velocity_towards(const Point& from, const Point& to) -> Point
+{
+    const Vector v = to - from;
+    const double d = std::sqrt(v.x * v.x + v.y * v.y);
+    if (d == 0.0) {
+        return { 0, 0 };
+    }
+    return { int(std::trunc(v.x * MONSTER_SPEED / d)), int(std::trunc(v.y * MONSTER_SPEED / d)) };
+}
+
+/**
+ * The state at the start of a game, without any monster.
+ */
+inline auto
+initial_state() -> State
+{
+    State s;
+    constexpr std::array<Point, 3> hero_offsets{ { { 1414, 849 }, { 1131, 1131 }, { 849, 1414 } } };
+    for (int p = 0; p < 2; ++p) {
+        Player& player = s.players[p];
+        player.id = p == 0 ? Player::Id::US : Player::Id::THEM;
+        player.base = base_of(p);
+        player.health = 3;
+        player.mana = 0;
+        for (int i = 0; i < 3; ++i) {
+            Hero& hero = player.heros.emplace_back();
+            hero.id = 3 * p + i;
+            hero.pos = p == 0 ? hero_offsets[i]
+                              : Point{ WIDTH - 1 - hero_offsets[i].x, HEIGHT - 1 - hero_offsets[i].y };
+            hero.shield_life = 0;
+            hero.is_controlled = false;
+        }
+    }
+    s.control_targets.fill(Point_None);
+    return s;
+}
+
+/**
+ * The player whose base a monster will reach if nobody interferes.
+ */
+inline auto
+threat_of(const Monster& m) -> int
+{
+    if (m.near_base) {
+        return in_range(m.pos, base_of(0), BASE_RADIUS) ? 0 : 1;
+    }
+    Point p = m.pos;
+    for (int t = 0; t < MAX_TURNS && is_inside_map(p); ++t) {
+        p += m.vel;
+        for (int player : { 0, 1 }) {
+            if (in_range(p, base_of(player), BASE_RADIUS)) {
+                return player;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * Whether the game is over, after a base's destruction or the last turn.
+ */
+inline auto
+is_over(const State& s) -> bool
+{
+    return s.players[0].health <= 0 || s.players[1].health <= 0 || s.turn >= MAX_TURNS;
+}
+
+/**
+ * The index of the winner of a game that is over, or -1 for a draw.
+ *
+ * The health of the bases decides, then the wild mana.
+ */
+inline auto
+winner(const State& s) -> int
+{
+    const auto key = [&s](int p) { return std::pair{ std::max(s.players[p].health, 0), s.wild_mana[p] }; };
+    return key(0) > key(1) ? 0 : key(1) > key(0) ? 1 : -1;
+}
+
+namespace details {
+
+inline auto
+find_hero(State& s, int id) -> Hero*
+{
+    if (id < 0 || id >= 6) {
+        return nullptr;
+    }
+    return &s.players[id / 3].heros[id % 3];
+}
+
+inline auto
+find_monster(State& s, int id) -> Monster*
+{
+    auto it = std::find_if(s.monsters.begin(), s.monsters.end(), [id](const auto& m) { return m.id == id; });
+    return it == s.monsters.end() ? nullptr : &*it;
+}
+
+/**
+ * Apply `f' to the entity with `id' if it can be the target of a spell cast from `from'.
+ */
+template<typename F>
+inline auto
+with_spell_target(State& s, int id, const Point& from, int range, F&& f) -> bool
+{
+    if (Hero* hero = find_hero(s, id); hero != nullptr) {
+        if (hero->shield_life > 0 || !in_range(from, hero->pos, range)) {
+            return false;
+        }
+        f(*hero);
+        return true;
+    }
+    if (Monster* monster = find_monster(s, id); monster != nullptr) {
+        if (monster->shield_life > 0 || !in_range(from, monster->pos, range)) {
+            return false;
+        }
+        f(*monster);
+        return true;
+    }
+    return false;
+}
+
+} // namespace details
+
+/**
+ * Advance the game by one turn.
+ *
+ * The order is the one of the statement:
+ * 1. CONTROL and SHIELD spells are applied to their targets,
+ * 2. the heroes move, the controlled ones towards where they were sent,
+ * 3. the heroes attack the monsters in range, gaining 1 mana per hit,
+ * 4. WIND spells push the entities around their caster,
+ * 5. the monsters which weren't pushed move, damaging the bases they reach,
+ * 6. the shields wear off.
+ *
+ * A spell is cast only if the player has the mana and the target is valid.
+ * Monsters are not spawned here, see the referee.
+ */
+inline void
+step(State& s, const Actions& actions)
+{
+    std::array<Point, 6> control_targets;
+    control_targets.fill(Point_None);
+
+    // Controlled heroes don't get to choose
+    auto action_of = [&](int id) -> Action {
+        if (s.control_targets[id] != Point_None) {
+            return Action{ s.control_targets[id] };
+        }
+        return actions[id / 3][id % 3];
+    };
+
+    for (auto& monster : s.monsters) {
+        monster.is_controlled = false;
+    }
+
+    // CONTROL and SHIELD
+    for (int id = 0; id < 6; ++id) {
+        const Action action = action_of(id);
+        Player& player = s.players[id / 3];
+        const Point caster = player.heros[id % 3].pos;
+        if (action.type != Action::Type::SPELL || action.spell.type == Spell::Type::WIND ||
+            player.mana < SPELL_COST) {
+            continue;
+        }
+        bool cast = false;
+        if (action.spell.type == Spell::Type::SHIELD) {
+            // Counting this turn's wear, the shield protects for the next SHIELD_DURATION turns
+            cast = details::with_spell_target(s, action.spell.target_id, caster, action.spell.range(),
+                                              [](auto& e) { e.shield_life = SHIELD_DURATION + 1; });
+        } else {
+            const Point target = action.target;
+            cast = details::with_spell_target(s, action.spell.target_id, caster, action.spell.range(), [&](auto& e) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(e)>, Hero>) {
+                    control_targets[e.id] = target;
+                } else {
+                    e.vel = velocity_towards(e.pos, target);
+                    e.near_base = false;
+                    e.is_controlled = true;
+                }
+            });
+        }
+        player.mana -= cast ? SPELL_COST : 0;
+    }
+
+    // Heroes move
+    for (int id = 0; id < 6; ++id) {
+        const Action action = action_of(id);
+        Hero& hero = s.players[id / 3].heros[id % 3];
+        if (action.type == Action::Type::MOVE) {
+            hero.pos = clamped_to_map(moved_towards(hero.pos, action.target, MAX_MOVE));
+        }
+    }
+
+    // Heroes attack
+    for (int p = 0; p < 2; ++p) {
+        for (const auto& hero : s.players[p].heros) {
+            for (auto& monster : s.monsters) {
+                if (monster.health > 0 && in_range(hero.pos, monster.pos, HERO_ATTACK_RADIUS)) {
+                    monster.health -= HERO_DAMAGE;
+                    ++s.players[p].mana;
+                    if (!in_range(monster.pos, base_of(p), BASE_RADIUS)) {
+                        ++s.wild_mana[p];
+                    }
+                }
+            }
+        }
+    }
+    s.monsters.erase(std::remove_if(s.monsters.begin(), s.monsters.end(), [](const auto& m) { return m.health <= 0; }),
+                     s.monsters.end());
+
+    // WIND, each caster pushing what is around it before the previous pushes
+    std::vector<bool> pushed(s.monsters.size(), false);
+    std::vector<std::pair<int, Vector>> pushes;
+    for (int id = 0; id < 6; ++id) {
+        const Action action = action_of(id);
+        Player& player = s.players[id / 3];
+        const Point caster = player.heros[id % 3].pos;
+        if (action.type != Action::Type::SPELL || action.spell.type != Spell::Type::WIND ||
+            player.mana < SPELL_COST || action.target == caster) {
+            continue;
+        }
+        player.mana -= SPELL_COST;
+        const Vector dir = action.target - caster;
+        const Vector push = dir * (WIND_PUSH / std::sqrt(dir.x * dir.x + dir.y * dir.y));
+        for (size_t m = 0; m < s.monsters.size(); ++m) {
+            if (s.monsters[m].shield_life == 0 && in_range(caster, s.monsters[m].pos, WIND_RANGE)) {
+                pushes.emplace_back(6 + m, push);
+            }
+        }
+        for (const auto& hero : s.players[1 - id / 3].heros) {
+            if (hero.shield_life == 0 && in_range(caster, hero.pos, WIND_RANGE)) {
+                pushes.emplace_back(hero.id, push);
+            }
+        }
+    }
+    for (auto [ndx, push] : pushes) {
+        Point& pos = ndx < 6 ? s.players[ndx / 3].heros[ndx % 3].pos : s.monsters[ndx - 6].pos;
+        push.p = pos;
+        pos = push.target();
+        if (ndx < 6) {
+            pos = clamped_to_map(pos);
+        } else {
+            pushed[ndx - 6] = true;
+        }
+    }
+
+    // Monsters move
+    for (size_t m = 0; m < s.monsters.size(); ++m) {
+        Monster& monster = s.monsters[m];
+        if (!pushed[m]) {
+            monster.pos += monster.vel;
+        }
+        for (int p : { 0, 1 }) {
+            if (in_range(monster.pos, base_of(p), BASE_DAMAGE_RADIUS)) {
+                --s.players[p].health;
+                monster.health = 0;
+            }
+        }
+        const int near = in_range(monster.pos, base_of(0), BASE_RADIUS)   ? 0
+                         : in_range(monster.pos, base_of(1), BASE_RADIUS) ? 1
+                                                                          : -1;
+        monster.near_base = near != -1;
+        if (monster.near_base && !monster.is_controlled) {
+            monster.vel = velocity_towards(monster.pos, base_of(near));
+        }
+        if (!monster.near_base && !is_inside_map(monster.pos)) {
+            monster.health = 0;
+        }
+    }
+    s.monsters.erase(std::remove_if(s.monsters.begin(), s.monsters.end(), [](const auto& m) { return m.health <= 0; }),
+                     s.monsters.end());
+
+    // Shields wear off
+    for (auto& player : s.players) {
+        for (auto& hero : player.heros) {
+            hero.shield_life = std::max(hero.shield_life - 1, 0);
+            hero.is_controlled = control_targets[hero.id] != Point_None;
+        }
+    }
+    for (auto& monster : s.monsters) {
+        monster.shield_life = std::max(monster.shield_life - 1, 0);
+    }
+
+    s.control_targets = control_targets;
+    ++s.turn;
+}
+
+} // namespace spring::sim
+
+#endif // SIMULATOR_H_
@@ -0,0 +1,213 @@
+#ifndef SPATIAL_H_
+#define SPATIAL_H_
+
+#include "types.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace spring {
+
+/**
+ * Uniform grid over the map, for proximity queries without scanning
+ * every entity.
+ *
+ * The points are bucketed by cells of a fixed size, typically the range
+ * of a spell, with a counting sort each time the grid is rebuilt (once a
+ * turn). Queries return the indices of the points in the range they were
+ * built from, and only compare squared distances.
+ *
+ * Points outside of the map are put in the closest cell.
+ */
+class SpatialIndex
+{
+public:
+    explicit SpatialIndex(int cell_size = 1280)
+            : m_cell{ cell_size }
+            , m_cols{ (WIDTH + cell_size - 1) / cell_size }
+            , m_rows{ (HEIGHT + cell_size - 1) / cell_size }
+    {}
+
+    /**
+     * Bucket the positions `pos(e)' of the entities `e' in the range
+     */
+    template<typename Range, typename Proj>
+    void build(const Range& entities, Proj pos)
+    {
+        m_points.clear();
+        for (const auto& e : entities) {
+            m_points.push_back(pos(e));
+        }
+
+        m_cell_start.assign(m_cols * m_rows + 1, 0);
+        for (const auto& p : m_points) {
+            ++m_cell_start[cell_of(p) + 1];
+        }
+        for (size_t c = 1; c < m_cell_start.size(); ++c) {
+            m_cell_start[c] += m_cell_start[c - 1];
+        }
+        m_items.resize(m_points.size());
+        m_fill.assign(m_cell_start.begin(), m_cell_start.end() - 1);
+        for (size_t i = 0; i < m_points.size(); ++i) {
+            m_items[m_fill[cell_of(m_points[i])]++] = i;
+        }
+    }
+
+    [[nodiscard]] auto size() const -> size_t { return m_points.size(); }
+
+    /**
+     * Call `f(i)' for each point i within `radius' of `center'
+     */
+    template<typename F>
+    void for_each_within(const Point& center, int radius, F&& f) const
+    {
+        const int r2 = radius * radius;
+        const int col0 = std::max((center.x - radius) / m_cell, 0);
+        const int col1 = std::min((center.x + radius) / m_cell, m_cols - 1);
+        const int row0 = std::max((center.y - radius) / m_cell, 0);
+        const int row1 = std::min((center.y + radius) / m_cell, m_rows - 1);
+
+        for (int row = row0; row <= row1; ++row) {
+            for (int col = col0; col <= col1; ++col) {
+                const int c = row * m_cols + col;
+                for (int k = m_cell_start[c]; k < m_cell_start[c + 1]; ++k) {
+                    if (distance2(m_points[m_items[k]], center) <= r2) {
+                        f(m_items[k]);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * The points within `radius' of `center', in no particular order
+     */
+    void within(const Point& center, int radius, std::vector<int>& out) const
+    {
+        out.clear();
+        for_each_within(center, radius, [&out](int i) { out.push_back(i); });
+    }
+
+    /**
+     * The closest point to `center' satisfying `pred(i)', or -1 if there is none
+     *
+     * Ties are broken by the smallest index, whatever the layout of the grid.
+     */
+    template<typename Pred>
+    [[nodiscard]] auto nearest(const Point& center, Pred pred) const -> int
+    {
+        int best = -1;
+        int best_d2 = std::numeric_limits<int>::max();
+        search_rings(center, [&](int i) {
+            const int d2 = distance2(m_points[i], center);
+            if ((d2 < best_d2 || (d2 == best_d2 && i < best)) && pred(i)) {
+                best = i;
+                best_d2 = d2;
+            }
+        }, [&](long long bound2) { return best != -1 && best_d2 <= bound2; });
+        return best;
+    }
+
+    /**
+     * The `k' closest points to `center', from the closest, ties by the smallest index
+     */
+    void k_nearest(const Point& center, size_t k, std::vector<int>& out) const
+    {
+        out.clear();
+        if (k == 0) {
+            return;
+        }
+        auto by_distance = [&](int a, int b) {
+            const int da = distance2(m_points[a], center);
+            const int db = distance2(m_points[b], center);
+            return da < db || (da == db && a < b);
+        };
+        search_rings(center, [&out](int i) { out.push_back(i); }, [&](long long bound2) {
+            if (out.size() < k) {
+                return false;
+            }
+            std::nth_element(out.begin(), out.begin() + (k - 1), out.end(), by_distance);
+            return distance2(m_points[out[k - 1]], center) <= bound2;
+        });
+        std::sort(out.begin(), out.end(), by_distance);
+        out.resize(std::min(out.size(), k));
+    }
+
+private:
+    int m_cell;
+    int m_cols;
+    int m_rows;
+    std::vector<Point> m_points;
+    /* Index in m_items of the first point of each cell */
+    std::vector<int> m_cell_start;
+    /* The points, sorted by cell */
+    std::vector<int> m_items;
+    /* Next free slot of each cell while building */
+    std::vector<int> m_fill;
+
+    [[nodiscard]] auto cell_of(const Point& p) const -> int
+    {
+        const int col = std::clamp(p.x / m_cell, 0, m_cols - 1);
+        const int row = std::clamp(p.y / m_cell, 0, m_rows - 1);
+        return row * m_cols + col;
+    }
+
+    /**
+     * Visit the cells in growing square rings around the center's cell,
+     * calling `visit(i)' on their points, until `done(bound2)' where
+     * `bound2' is the squared distance under which no point is left.
+     */
+    template<typename Visit, typename Done>
+    void search_rings(const Point& center, Visit&& visit, Done&& done) const
+    {
+        constexpr long long unbounded = std::numeric_limits<long long>::max();
+        const int ccol = std::clamp(center.x / m_cell, 0, m_cols - 1);
+        const int crow = std::clamp(center.y / m_cell, 0, m_rows - 1);
+
+        for (int r = 0;; ++r) {
+            const int col0 = ccol - r, col1 = ccol + r;
+            const int row0 = crow - r, row1 = crow + r;
+            auto visit_cell = [&](int row, int col) {
+                const int c = row * m_cols + col;
+                for (int k = m_cell_start[c]; k < m_cell_start[c + 1]; ++k) {
+                    visit(m_items[k]);
+                }
+            };
+            for (int row = std::max(row0, 0); row <= std::min(row1, m_rows - 1); ++row) {
+                if (row == row0 || row == row1) {
+                    for (int col = std::max(col0, 0); col <= std::min(col1, m_cols - 1); ++col) {
+                        visit_cell(row, col);
+                    }
+                    continue;
+                }
+                if (col0 >= 0) {
+                    visit_cell(row, col0);
+                }
+                if (col1 < m_cols && col1 != col0) {
+                    visit_cell(row, col1);
+                }
+            }
+
+            // Distance to the closest side of the square with cells left beyond it
+            long long bound = unbounded;
+            if (col0 > 0) bound = std::min<long long>(bound, center.x - col0 * m_cell);
+            if (col1 < m_cols - 1) bound = std::min<long long>(bound, (col1 + 1) * m_cell - center.x);
+            if (row0 > 0) bound = std::min<long long>(bound, center.y - row0 * m_cell);
+            if (row1 < m_rows - 1) bound = std::min<long long>(bound, (row1 + 1) * m_cell - center.y);
+
+            if (bound == unbounded) {
+                done(unbounded);
+                return;
+            }
+            bound = std::max(bound, 0LL);
+            if (done(bound * bound)) {
+                return;
+            }
+        }
+    }
+};
+
+} // namespace spring
+
+#endif // SPATIAL_H_
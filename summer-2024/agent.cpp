@@ -1,10 +1,13 @@
 #include "agent.h"
+#include "tables.h"
 
 #include <algorithm>
 #include <cassert>
 #include <deque>
 #include <fstream>
 #include <iostream>
+#include <random>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -17,6 +20,124 @@ std::unordered_map<char, int> action_index {
   {'L', 0}, {'U', 1}, {'R', 2}, {'D', 3}
 };
 
+using Clock = std::chrono::steady_clock;
+
+/// The tables of the current runs
+HurdleTable hurdle_table;
+ArcheryTable archery_table;
+DivingTable diving_table;
+
+/**
+ * @brief Sum of the values of the rollouts started with one root action.
+ *
+ * Aligned so that the threads don't share a cache line.
+ */
+struct alignas(64) Rollouts {
+    double sum = 0;
+    long count = 0;
+};
+
+int medal_points(Medal medal) {
+    switch (medal) {
+        case Medal::GOLD:
+            return 3;
+        case Medal::SILVER:
+            return 1;
+        case Medal::BRONZE:
+            return 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief Points of `player_id' in a mini-game, a run still going being ranked as it stands.
+ */
+template<typename MiniGame>
+int points(const Olymbits& game, const MiniGame& mini_game, int g, int player_id) {
+    int p = game.score()[player_id][g];
+    if (!mini_game.is_terminal()) {
+        p += medal_points(mini_game.score()[player_id]);
+    }
+    return p;
+}
+
+/**
+ * @brief Value of the game for `player_id': the product of their points in each mini-game.
+ *
+ * One is added to the points so that a mini-game without any medal yet
+ * doesn't hide the progress made in the others.
+ */
+double evaluate(const Olymbits& game, int player_id) {
+    std::array<int, 4> p {
+        points(game, game.hurdle_race(), 0, player_id),
+        points(game, game.archery(), 1, player_id),
+        points(game, game.skating(), 2, player_id),
+        points(game, game.diving(), 3, player_id),
+    };
+    double value = 1;
+    for (int g = 0; g < game.n_games(); ++g) {
+        value *= p[g] + 1;
+    }
+    return value;
+}
+
+/**
+ * @brief Action of `player_id' in a rollout.
+ *
+ * Half of the time it is the action with the smallest total cost, the costs of
+ * each mini-game being scaled to at most 1, the other half it is uniformly random.
+ */
+template<typename Engine>
+Action rollout_action(const Olymbits& game, int player_id, Engine& eng) {
+    const auto r = eng();
+    if (r & 1) {
+        return Action(r >> 1 & 3);
+    }
+    const auto costs = action_costs(game, player_id);
+    std::array<float, 4> total {};
+    for (const auto& c : costs) {
+        const float scale = 1.f / std::max(1, *std::max_element(c.begin(), c.end()));
+        for (int a = 0; a < 4; ++a) {
+            total[a] += c[a] * scale;
+        }
+    }
+    return Action(std::min_element(total.begin(), total.end()) - total.begin());
+}
+
+/**
+ * @brief Play rollouts starting with `root' until the deadline.
+ *
+ * The actions of all the players, the opponents included, are chosen by
+ * rollout_action(), except for the player's first one. A rollout stops when
+ * the runs of all the mini-games are over, since the following ones are unknown.
+ */
+void rollouts(const Olymbits& game, Action root, Clock::time_point deadline,
+              unsigned seed, Rollouts& out) {
+    std::minstd_rand eng{ seed };
+    const int player_id = game.player_id();
+
+    do {
+        Olymbits sim = game;
+        std::array<Action, 3> actions;
+        for (int i = 0; i < 3; ++i) {
+            actions[i] = i == player_id ? root : rollout_action(sim, i, eng);
+        }
+
+        while (true) {
+            sim.step(actions);
+            if (sim.runs_over() || sim.is_terminal()) {
+                break;
+            }
+            for (int i = 0; i < 3; ++i) {
+                actions[i] = rollout_action(sim, i, eng);
+            }
+        }
+
+        out.sum += evaluate(sim, player_id);
+        ++out.count;
+    } while (Clock::now() < deadline);
+}
+
 }  // namespace
 
 void swap_players_default(State& state, int player_id) {
@@ -44,7 +165,7 @@ std::array<int, 4> weight_hurdle_actions(const State& state) {
     auto pos = state.regs[0];
     auto stun = state.regs[1];
 
-    if (stun > 0 or state.gpu == "GAME OVER") {
+    if (stun > 0 or state.gpu == "GAME_OVER") {
         return weights;
     }
 
@@ -76,7 +197,7 @@ std::array<int, 4> weight_hurdle_actions(const State& state) {
 std::array<int, 4> weight_archery_actions(const State& state) {
     std::array<int, 4> weights = {0, 0, 0, 0};
 
-    if (state.gpu == "GAME OVER") {
+    if (state.gpu == "GAME_OVER") {
         return weights;
     }
 
@@ -89,7 +210,7 @@ std::array<int, 4> weight_skating_actions(const State& state) {
     auto pos = state.regs[0];
     auto risk = state.regs[3];
 
-    if (risk < 0 or state.gpu == "GAME OVER") {
+    if (risk < 0 or state.gpu == "GAME_OVER") {
         return weights;
     }
 
@@ -130,7 +251,7 @@ std::array<int, 4> weight_skating_actions(const State& state) {
 std::array<int, 4> weight_diving_actions(const State& state) {
     std::array<int, 4> weights = {0, 0, 0, 0};
 
-    if (state.gpu == "GAME OVER") {
+    if (state.gpu == "GAME_OVER") {
         return weights;
     }
 
@@ -139,6 +260,53 @@ std::array<int, 4> weight_diving_actions(const State& state) {
     return weights;
 }
 
+void solve_tables(const Olymbits& game) {
+    hurdle_table.reset(game.hurdle_race());
+    archery_table.reset(game.archery());
+    diving_table.reset(game.diving());
+}
+
+std::array<std::array<int, 4>, 4> action_costs(const Olymbits& game, int player_id) {
+    return {
+        hurdle_table.costs(game.hurdle_race(), player_id),
+        archery_table.costs(game.archery(), player_id),
+        std::array<int, 4>{0, 0, 0, 0},
+        diving_table.costs(game.diving(), player_id),
+    };
+}
+
+Action best_action(const Olymbits& game, std::chrono::milliseconds budget) {
+    const auto deadline = Clock::now() + budget;
+    solve_tables(game);
+
+    // Nothing to simulate during the reset turns
+    if (game.runs_over()) {
+        auto weights = get_action_weights(game);
+        return Action(std::max_element(weights.begin(), weights.end()) - weights.begin());
+    }
+
+    std::array<Rollouts, 4> results;
+    std::vector<std::thread> threads;
+    for (int a = 0; a < 4; ++a) {
+        threads.emplace_back(rollouts, std::cref(game), Action(a), deadline,
+                             2024u + a, std::ref(results[a]));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    int best = 0;
+    for (int a = 0; a < 4; ++a) {
+        std::cerr << results[a].sum / results[a].count << " (" << results[a].count << ") ";
+        if (results[a].sum / results[a].count > results[best].sum / results[best].count) {
+            best = a;
+        }
+    }
+    std::cerr << std::endl;
+
+    return Action(best);
+}
+
 std::array<int, 4> get_action_weights(const Olymbits& game) {
     auto player_id = game.player_id();
     auto states = game.state();
@@ -3,12 +3,38 @@
 
 #include "olymbits.h"
 
+#include <chrono>
 #include <iosfwd>
 
 namespace olymbits {
 
 std::array<int, 4> get_action_weights(const Olymbits& game);
 
+/**
+ * @brief Solve the tables of the mini-games' runs which just started.
+ *
+ * The tables are kept until the next runs, see tables.h.
+ */
+void solve_tables(const Olymbits& game);
+
+/**
+ * @brief Cost of each action of `player_id' in each mini-game, from the tables.
+ *
+ * The risk order of the Roller Speed Skating being only known for the current
+ * turn, its costs are all 0.
+ */
+std::array<std::array<int, 4>, 4> action_costs(const Olymbits& game, int player_id);
+
+/**
+ * @brief Choose the action of the player by Monte Carlo search over the four mini-games.
+ *
+ * Each root action gets its own thread playing rollouts until the budget is
+ * spent, every player's actions being sampled around the tables' costs. The action
+ * whose rollouts end with the best mean product of points (see Olymbits::score())
+ * is chosen.
+ */
+Action best_action(const Olymbits& game, std::chrono::milliseconds budget);
+
 } // namespace tb
 
 #endif // __AGENT_H_
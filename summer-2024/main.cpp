@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <iostream>
 #include <numeric>
 #include <string>
@@ -33,18 +34,8 @@ int main() {
   while (true) {
     game.turn_init(std::cin);
 
-    auto action_weights = get_action_weights(game);
-
-    std::array<int, 4> order {0, 1, 2, 3};
-    for (int i = 0; i < 4; ++i) {
-      std::cerr << action_weights[i] << ' ';
-    }
-    std::cerr << std::endl;
-
-    std::sort(order.begin(), order.end(), [&](int a, int b) {
-      return action_weights[a] > action_weights[b];
-    });
-
-    std::cout << Action(order[0]) << std::endl;
+    // The first turn allows 1000ms, the others 50ms
+    const auto budget = std::chrono::milliseconds(game.n_turns() == 0 ? 900 : 40);
+    std::cout << best_action(game, budget) << std::endl;
   }
 }
@@ -2,14 +2,15 @@
 
 #include <array>
 #include <algorithm>
+#include <bit>
 #include <iostream>
-#include <numeric>
 #include <sstream>
-#include <stdexcept>
 
 namespace olymbits {
 
 namespace {
+    static constexpr const char* game_over = "GAME_OVER";
+
     static constexpr auto action_to_char = [](Action action) {
         switch (action) {
             case Action::LEFT:
@@ -21,282 +22,314 @@ namespace {
             case Action::DOWN:
                 return 'D';
         }
+        return 'U';
+    };
+
+    static constexpr auto char_to_action = [](char c) {
+        switch (c) {
+            case 'L':
+                return Action::LEFT;
+            case 'R':
+                return Action::RIGHT;
+            case 'D':
+                return Action::DOWN;
+            default:
+                return Action::UP;
+        }
     };
+
+    /// The state of a game whose run is over, keeping its last registers.
+    State over_state(std::array<int, 7> regs) {
+        return State{ game_over, regs };
+    }
 }  // namespace
 
-void MiniGame::update(std::istream& is) {
-    m_state.gpu.clear();
-    is >> m_state.gpu >> m_state.regs[0] >> m_state.regs[1]
-       >> m_state.regs[2] >> m_state.regs[3] >> m_state.regs[4]
-       >> m_state.regs[5] >> m_state.regs[6];
-    is.ignore();
+std::array<Medal, 3> medals_from(const std::array<int, 3>& results) {
+    std::array<Medal, 3> medals;
+    for (int i = 0; i < 3; ++i) {
+        int n_better = 0;
+        for (int j = 0; j < 3; ++j) {
+            n_better += results[j] > results[i];
+        }
+        medals[i] = Medal(n_better);
+    }
+    return medals;
 }
 
-void HurdleRace::step(const std::array<Action, 3>& actions) {
-    static constexpr auto find_next_hurdle = [](const std::string& gpu, int position) {
-        auto hurdle = std::find(gpu.begin() + position, gpu.end(), '#');
-        return hurdle == gpu.end() ? -1 : std::distance(gpu.begin(), hurdle);
+void HurdleRace::update(const State& state) {
+    over = state.gpu == game_over;
+    for (int i = 0; i < 3; ++i) {
+        position[i] = state.regs[i];
+        stun_timer[i] = state.regs[3 + i];
+    }
+    if (over) {
+        return;
+    }
+    hurdles = 0;
+    for (size_t i = 0; i < state.gpu.size(); ++i) {
+        hurdles |= uint32_t(state.gpu[i] == '#') << i;
+    }
+    finish = state.gpu.size() - 1;
+}
+
+State HurdleRace::state() const {
+    std::array<int, 7> regs {
+        position[0], position[1], position[2],
+        stun_timer[0], stun_timer[1], stun_timer[2], -1
     };
+    if (over) {
+        return over_state(regs);
+    }
+    std::string gpu(finish + 1, '.');
+    for (int i = 0; i <= finish; ++i) {
+        if (hurdles >> i & 1) {
+            gpu[i] = '#';
+        }
+    }
+    return State{ gpu, regs };
+}
+
+void HurdleRace::step(const std::array<Action, 3>& actions) {
+    static constexpr std::array<int, 4> move_distance = {1, 2, 3, 2};
 
-    if (m_state.gpu == "GAME OVER") {
+    if (over) {
         return;
     }
     for (auto player_id : {0, 1, 2}) {
         const auto action = actions[player_id];
-        int& position = m_state.regs[player_id];
-        int& stun_timer = m_state.regs[3 + player_id];
+        int pos = position[player_id];
 
-        if (stun_timer > 0) {
-            --stun_timer;
+        if (stun_timer[player_id] > 0) {
+            --stun_timer[player_id];
             continue;
         }
 
-        int move_distance = 0;
-        int next_hurdle = find_next_hurdle(m_state.gpu, position);
-
-        switch (action) {
-            case Action::UP:
-                move_distance = 2;
-                break;
-            case Action::LEFT:
-                move_distance = 1;
-                break;
-            case Action::DOWN:
-                move_distance = 2;
-                break;
-            case Action::RIGHT:
-                move_distance = 3;
-                break;
-        }
-
-        if (action != Action::UP) {
-            position = std::min(position + move_distance, next_hurdle);
+        if (action == Action::UP) {
+            // Jumps over the next space, only landing on a hurdle stuns
+            pos += 2;
+            if (hurdles >> pos & 1) {
+                stun_timer[player_id] = 3;
+            }
         } else {
-            position += move_distance;
+            // The first hurdle on the way stops the move
+            const int distance = move_distance[int(action)];
+            const uint32_t ahead = hurdles >> (pos + 1) & ((1u << distance) - 1);
+            if (ahead) {
+                pos += std::countr_zero(ahead) + 1;
+                stun_timer[player_id] = 3;
+            } else {
+                pos += distance;
+            }
         }
 
-        if (position == next_hurdle) {
-            stun_timer = 3;
-        }
-    }
-    if (std::any_of(m_state.regs.begin(), m_state.regs.begin() + 3, [&](int position) {
-        return position >= 30;
-    })) {
-        m_state.gpu = "GAME OVER";
+        position[player_id] = std::min<int>(pos, finish);
     }
+    over = position[0] == finish || position[1] == finish || position[2] == finish;
 }
 
 std::array<Medal, 3> HurdleRace::score() const {
-    if (m_state.gpu != "GAME OVER") {
-        throw std::runtime_error("Game is not over yet");
-    }
-    std::array<Medal, 3> medals = {Medal::BRONZE, Medal::BRONZE, Medal::BRONZE};
-
-    std::array<int, 3> positions;
-    std::transform(m_state.regs.begin(), m_state.regs.begin() + 3, positions.begin(), [](int position) {
-        return std::min(position, 30);
-    });
-
-    std::array<int, 3> players = {0, 1, 2};
-    std::sort(players.begin(), players.end(), [&](int a, int b) {
-        return positions[a] > positions[b];
-    });
+    return medals_from({ position[0], position[1], position[2] });
+}
 
-    medals[players[0]] = Medal::GOLD;
-    if (positions[players[1]] == positions[players[0]]) {
-        medals[players[1]] = Medal::GOLD;
-    } else {
-        medals[players[1]] = Medal::SILVER;
+void Archery::update(const State& state) {
+    over = state.gpu == game_over;
+    for (int i = 0; i < 3; ++i) {
+        x[i] = state.regs[2 * i];
+        y[i] = state.regs[2 * i + 1];
+    }
+    if (over) {
+        return;
     }
-    if (positions[players[2]] == positions[players[1]]) {
-        medals[players[2]] = medals[players[1]];
+    cursor = 0;
+    length = std::min(state.gpu.size(), wind.size());
+    for (int i = 0; i < length; ++i) {
+        wind[i] = state.gpu[i] - '0';
     }
+}
 
-    return medals;
+State Archery::state() const {
+    std::array<int, 7> regs { x[0], y[0], x[1], y[1], x[2], y[2], -1 };
+    if (over) {
+        return over_state(regs);
+    }
+    std::string gpu;
+    for (int i = cursor; i < length; ++i) {
+        gpu.push_back('0' + wind[i]);
+    }
+    return State{ gpu, regs };
 }
 
 void Archery::step(const std::array<Action, 3>& actions) {
-    if (m_state.gpu == "GAME OVER") {
+    if (over) {
         return;
     }
+    const int wind_strength = wind[cursor];
     for (auto player_id : {0, 1, 2}) {
-        const auto action = actions[player_id];
-        int& x = m_state.regs[player_id * 2];
-        int& y = m_state.regs[player_id * 2 + 1];
-        int wind_strength = m_state.gpu[0] - '0';
-
-        switch (action) {
+        int dx = 0;
+        int dy = 0;
+        switch (actions[player_id]) {
             case Action::UP:
-                y += wind_strength;
+                dy = wind_strength;
                 break;
             case Action::DOWN:
-                y -= wind_strength;
+                dy = -wind_strength;
                 break;
             case Action::LEFT:
-                x -= wind_strength;
+                dx = -wind_strength;
                 break;
             case Action::RIGHT:
-                x += wind_strength;
+                dx = wind_strength;
                 break;
         }
 
         // Ensure coordinates are within bounds [-20, 20]
-        x = std::clamp(x, -20, 20);
-        y = std::clamp(y, -20, 20);
-    }
-    m_state.gpu.erase(0, 1);
-    if (m_state.gpu.empty()) {
-        m_state.gpu = "GAME OVER";
+        x[player_id] = std::clamp(x[player_id] + dx, -20, 20);
+        y[player_id] = std::clamp(y[player_id] + dy, -20, 20);
     }
+    over = ++cursor == length;
 }
 
 std::array<Medal, 3> Archery::score() const {
-    if (m_state.gpu != "GAME OVER") {
-        throw std::runtime_error("Game is not over yet");
+    // The closest to the target wins
+    std::array<int, 3> results;
+    for (int i = 0; i < 3; ++i) {
+        results[i] = -(x[i] * x[i] + y[i] * y[i]);
     }
-    std::array<Medal, 3> medals = {Medal::BRONZE, Medal::BRONZE, Medal::BRONZE};
-
-    std::array<int, 3> players = {0, 1, 2};
-    std::array<float, 3> distances;
-    std::transform(players.begin(), players.end(), distances.begin(), [&](int player_id) {
-        int x = m_state.regs[player_id * 2];
-        int y = m_state.regs[player_id * 2 + 1];
-        return x * x + y * y;
-    });
-    std::sort(players.begin(), players.end(), [&](int a, int b) {
-        return distances[a] > distances[b];
-    });
+    return medals_from(results);
+}
 
-    medals[players[0]] = Medal::GOLD;
-    if (distances[players[1]] == distances[players[0]]) {
-        medals[players[1]] = Medal::GOLD;
-    } else {
-        medals[players[1]] = Medal::SILVER;
+void RollerSpeedSkating::update(const State& state) {
+    over = state.gpu == game_over;
+    for (int i = 0; i < 3; ++i) {
+        spaces_traveled[i] = state.regs[i];
+        risk[i] = state.regs[3 + i];
+    }
+    turns_left = state.regs[6];
+    if (over) {
+        return;
     }
-    if (distances[players[2]] == distances[players[1]]) {
-        medals[players[2]] = medals[players[1]];
+    for (int i = 0; i < 4; ++i) {
+        risk_index[int(char_to_action(state.gpu[i]))] = i;
     }
+}
 
-    return medals;
+State RollerSpeedSkating::state() const {
+    std::array<int, 7> regs {
+        spaces_traveled[0], spaces_traveled[1], spaces_traveled[2],
+        risk[0], risk[1], risk[2], turns_left
+    };
+    if (over) {
+        return over_state(regs);
+    }
+    std::string gpu(4, ' ');
+    for (auto action : {Action::LEFT, Action::UP, Action::RIGHT, Action::DOWN}) {
+        gpu[risk_index[int(action)]] = action_to_char(action);
+    }
+    return State{ gpu, regs };
 }
 
 void RollerSpeedSkating::step(const std::array<Action, 3>& actions) {
-    if (m_state.gpu == "GAME OVER") {
+    if (over) {
         return;
     }
+    std::array<bool, 3> moved {};
     for (auto player_id : {0, 1, 2}) {
-        const auto action = actions[player_id];
-        int& spaces_traveled = m_state.regs[player_id];
-        int& risk = m_state.regs[3 + player_id];
-        if (risk < 0) {
-            ++risk;
+        if (risk[player_id] < 0) {
+            ++risk[player_id];
             continue;
         }
-        auto action_char = action_to_char(action);
-        auto risk_index = m_state.gpu.find(action_char);
-
-        auto risk_delta = risk_index - 2;
-        auto spaces_delta = risk_delta + 2;
-
-        risk += risk_delta;
-        spaces_traveled += spaces_delta;
+        // The action at index i moves by i + 1 spaces, and changes the risk by i - 1
+        const int index = risk_index[int(actions[player_id])];
+        spaces_traveled[player_id] += index + 1;
+        risk[player_id] = std::max(risk[player_id] + index - 1, 0);
+        moved[player_id] = true;
     }
 
-    // Check for collision with other players
+    // Check for collision with other players, once per player
     for (auto player_id : {0, 1, 2}) {
+        if (!moved[player_id]) {
+            continue;
+        }
         for (auto other_player_id : {0, 1, 2}) {
-            if (other_player_id != player_id && (m_state.regs[player_id] % 10 == m_state.regs[other_player_id] % 10)) {
-                int& player_risk = m_state.regs[3 + player_id];
-                int& other_player_risk = m_state.regs[3 + other_player_id];
-                if (player_risk >= 0) {
-                    player_risk += 2;
-                }
-                if (other_player_risk >= 0) {
-                    other_player_risk += 2;
-                }
+            if (other_player_id != player_id
+                && spaces_traveled[player_id] % 10 == spaces_traveled[other_player_id] % 10) {
+                risk[player_id] += 2;
+                break;
             }
         }
     }
 
-    // Set players to `stunned` if their risk is above 5
+    // Set players to `stunned` if their risk is 5 or more
     for (auto player_id : {0, 1, 2}) {
-        int& risk = m_state.regs[3 + player_id];
-        if (risk >= 5) {
-            risk = -2;
+        if (risk[player_id] >= 5) {
+            risk[player_id] = -2;
         }
     }
 
-    --m_state.regs[6];
-    if (m_state.regs[6] == 0) {
-        m_state.gpu = "GAME OVER";
-    }
+    over = --turns_left <= 0;
 }
 
 std::array<Medal, 3> RollerSpeedSkating::score() const {
-    if (m_state.gpu != "GAME OVER") {
-        throw std::runtime_error("Game is not over yet");
-    }
-    std::array<Medal, 3> medals = {Medal::BRONZE, Medal::BRONZE, Medal::BRONZE};
-    std::array<int, 3> players = {0, 1, 2};
-    std::sort(players.begin(), players.end(), [&](int a, int b) {
-        return m_state.regs[a] > m_state.regs[b];
-    });
+    return medals_from({ spaces_traveled[0], spaces_traveled[1], spaces_traveled[2] });
+}
 
-    medals[players[0]] = Medal::GOLD;
-    if (m_state.regs[players[1]] == m_state.regs[players[0]]) {
-        medals[players[1]] = Medal::GOLD;
-    } else {
-        medals[players[1]] = Medal::SILVER;
+void Diving::update(const State& state) {
+    over = state.gpu == game_over;
+    for (int i = 0; i < 3; ++i) {
+        points[i] = state.regs[i];
+        combo[i] = state.regs[3 + i];
     }
-    if (m_state.regs[players[2]] == m_state.regs[players[1]]) {
-        medals[players[2]] = medals[players[1]];
+    if (over) {
+        return;
+    }
+    cursor = 0;
+    length = std::min(state.gpu.size(), goal.size());
+    for (int i = 0; i < length; ++i) {
+        goal[i] = char_to_action(state.gpu[i]);
     }
+}
 
-    return medals;
+State Diving::state() const {
+    std::array<int, 7> regs {
+        points[0], points[1], points[2],
+        combo[0], combo[1], combo[2], -1
+    };
+    if (over) {
+        return over_state(regs);
+    }
+    std::string gpu;
+    for (int i = cursor; i < length; ++i) {
+        gpu.push_back(action_to_char(goal[i]));
+    }
+    return State{ gpu, regs };
 }
 
 void Diving::step(const std::array<Action, 3>& actions) {
-    if (m_state.gpu == "GAME OVER") {
+    if (over) {
         return;
     }
+    const Action diving_goal = goal[cursor];
     for (auto player_id : {0, 1, 2}) {
-        const auto action = actions[player_id];
-        int& points = m_state.regs[player_id];
-        int& combo = m_state.regs[3 + player_id];
-        char diving_goal = m_state.gpu[0];
-
-        if (diving_goal == action_to_char(action)) {
-            ++combo;
-            points += combo;
+        if (actions[player_id] == diving_goal) {
+            ++combo[player_id];
+            points[player_id] += combo[player_id];
         } else {
-            combo = 1;
+            combo[player_id] = 1;
         }
     }
-    m_state.gpu.erase(0, 1);
-    if (m_state.gpu.empty()) {
-        m_state.gpu = "GAME OVER";
-    }
+    over = ++cursor == length;
 }
 
 std::array<Medal, 3> Diving::score() const {
-    if (m_state.gpu != "GAME OVER") {
-        throw std::runtime_error("Game is not over yet");
-    }
-    std::array<Medal, 3> medals = {Medal::BRONZE, Medal::BRONZE, Medal::BRONZE};
-    std::array<int, 3> players = {0, 1, 2};
-    std::sort(players.begin(), players.end(), [&](int a, int b) {
-        return m_state.regs[a] > m_state.regs[b];
-    });
-    medals[players[0]] = Medal::GOLD;
-    if (m_state.regs[players[1]] == m_state.regs[players[0]]) {
-        medals[players[1]] = Medal::GOLD;
-    } else {
-        medals[players[1]] = Medal::SILVER;
-    }
-    if (m_state.regs[players[2]] == m_state.regs[players[1]]) {
-        medals[players[2]] = medals[players[1]];
-    }
-    return medals;
+    return medals_from({ points[0], points[1], points[2] });
+}
+
+template<typename F>
+void Olymbits::for_each_game(F&& f) {
+    if (m_ngames > 0) f(m_hurdle_race, 0);
+    if (m_ngames > 1) f(m_archery, 1);
+    if (m_ngames > 2) f(m_skating, 2);
+    if (m_ngames > 3) f(m_diving, 3);
 }
 
 void Olymbits::init(std::istream& is) {
@@ -306,6 +339,8 @@ void Olymbits::init(std::istream& is) {
 
 void Olymbits::turn_init(std::istream& is) {
     static std::string buf;
+    // Keep the count of the live game's turns, so that rollouts stop at its end
+    m_nturns = m_ninputs++;
     for (int i = 0; i < 3; ++i) {
         std::getline(is, buf);
         std::istringstream ss{buf};
@@ -320,17 +355,26 @@ void Olymbits::turn_init(std::istream& is) {
             m_scores[i][g] = 3 * medals[g][0] + medals[g][1];
         }
     }
-    for (int g = 0; g < m_ngames; ++g) {
-        m_mini_games[g]->update(is);
-    }
+
+    State state;
+    for_each_game([&](auto& game, int) {
+        is >> state.gpu >> state.regs[0] >> state.regs[1]
+           >> state.regs[2] >> state.regs[3] >> state.regs[4]
+           >> state.regs[5] >> state.regs[6];
+        is.ignore();
+        game.update(state);
+    });
 }
 
-void Olymbits::step(std::array<Action, 3> action) {
-    for (int g = 0; g < m_ngames; ++g) {
-        const auto& mini_game = m_mini_games[g];
-        mini_game->step(action);
-        if (mini_game->is_terminal()) {
-            auto score = mini_game->score();
+void Olymbits::step(const std::array<Action, 3>& action) {
+    for_each_game([&](auto& game, int g) {
+        if (game.is_terminal()) {
+            return;
+        }
+        game.step(action);
+        // Medals are only given once, at the end of the run
+        if (game.is_terminal()) {
+            auto score = game.score();
             for (int i = 0; i < 3; ++i) {
                 switch (score[i]) {
                     case Medal::GOLD:
@@ -344,16 +388,24 @@ void Olymbits::step(std::array<Action, 3> action) {
                 }
             }
         }
-    }
+    });
     ++m_nturns;
 }
 
+bool Olymbits::runs_over() const {
+    return (m_ngames < 1 || m_hurdle_race.is_terminal())
+        && (m_ngames < 2 || m_archery.is_terminal())
+        && (m_ngames < 3 || m_skating.is_terminal())
+        && (m_ngames < 4 || m_diving.is_terminal());
+}
+
 std::array<State, 4> Olymbits::state() const {
-    std::array<State, 4> states;
-    std::transform(m_mini_games.begin(), m_mini_games.end(), states.begin(), [](const auto& game) {
-        return game->state();
-    });
-    return states;
+    return {
+        m_hurdle_race.state(),
+        m_archery.state(),
+        m_skating.state(),
+        m_diving.state(),
+    };
 }
 
 } // namespace olymbits
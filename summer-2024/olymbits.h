@@ -2,16 +2,15 @@
 #define __OLYMBITS_H__
 
 #include <array>
-#include <cmath>
+#include <cstdint>
 #include <iosfwd>
-#include <memory>
 #include <string>
-#include <vector>
+#include <type_traits>
 
 namespace olymbits {
 
 /**
- * @brief Struct reprensenting the State of a mini-game.
+ * @brief Struct reprensenting the registers of a mini-game, as read from the input.
  */
 struct State {
     std::string gpu;
@@ -35,171 +34,156 @@ enum class Medal {
 };
 
 /**
- * @brief Base class representing a generic mini-game.
+ * @brief Compute the medals of the three players from their results, the highest being the best.
  *
- * This class serves as an interface for the various mini-games in the
- * Olymbits challenge. It provides a common structure for storing game
- * state and defining essential methods.
+ * Tied players win the same highest medal.
  */
-class MiniGame {
-public:
-    /**
-     * @brief Default constructor for the MiniGame class.
-     */
-    MiniGame() = default;
-
-    /**
-     * @brief Sets the state of the mini-game.
-     *
-     * This method updates the ASCII representation or other relevant string data
-     * for the mini-game and the array of registers used by the mini-game.
-     *
-     * @param gpu ASCII representation or other relevant string data for the mini-game.
-     * @param regs Array of 7 integers representing the registers used by the mini-game.
-     */
-    virtual void set_state(State state) {
-        m_state = state;
-    }
-
-    /**
-     * @brief Return the current state of the mini-game.
-     */
-    virtual State state() const {
-        return m_state;
-    };
-
-    /**
-     * @brief Update the current state of the mini-game from the input stream.
-     */
-    virtual void update(std::istream&);
-
-    /**
-     * @brief Advances the game state to the next turn according to the given action.
-     *
-     * This is a pure virtual method that must be implemented by derived classes to define
-     * the logic for advancing the game state.
-     */
-    virtual void step(const std::array<Action, 3>&) = 0;
+std::array<Medal, 3> medals_from(const std::array<int, 3>& results);
 
-    /**
-     * @brief Verifies if the mini-game has ended.
-     *
-     * This simply checks whether the `gpu` string is equal to "GAME OVER".
-     */
-    virtual bool is_terminal() const {
-        return m_state.gpu == "GAME OVER";
-    }
+/**
+ * @brief The Hurdle Race mini-game.
+ *
+ * In this mini-game, players race on a track with hurdles. The goal is to finish the race
+ * as quickly as possible while avoiding hurdles that can stun the player.
+ *
+ * The mini-games are plain data so that the whole Olymbits challenge can be copied
+ * with a memcpy, and their methods are not virtual so that they can be inlined.
+ */
+struct HurdleRace {
+    /// Bit i is set when there is a hurdle on space i.
+    uint32_t hurdles;
+    /// The last space of the track.
+    int8_t finish;
+    std::array<int8_t, 3> position;
+    std::array<int8_t, 3> stun_timer;
+    bool over;
 
     /**
-     * @brief Compute the medals earned by each players in the mini-game once it is over.
-     *
-     * This is a pure virtual method that must be implemented by derived classes to define
-     * the logic for computing the score of each player.
+     * @brief Set the state from the registers read in the input.
      */
-    virtual std::array<Medal, 3> score() const = 0;
+    void update(const State&);
 
     /**
-     * @brief Compute the score of each players in the mini-game.
+     * @brief Return the registers corresponding to the state.
      */
+    State state() const;
 
-    /**
-     * @brief Virtual destructor for the MiniGame class.
-     */
-    virtual ~MiniGame() = default;
-
-protected:
-    State m_state;
-};
-
-
-/**
- * @brief Class representing the Hurdle Race mini-game.
- *
- * In this mini-game, players race on a track with hurdles. The goal is to finish the race
- * as quickly as possible while avoiding hurdles that can stun the player.
- */
-class HurdleRace : public MiniGame {
-public:
     /**
      * @brief Advances the Hurdle Race game state to the next turn.
-     *
-     * This method implements the logic for progressing the Hurdle Race mini-game by one turn.
      */
-    void step(const std::array<Action, 3>&) override;
+    void step(const std::array<Action, 3>&);
+
+    bool is_terminal() const { return over; }
 
     /**
      * @brief Compute the medals earned by each players in once the HurdleRace is over.
      */
-    std::array<Medal, 3> score() const override;
+    std::array<Medal, 3> score() const;
 };
 
 /**
- * @brief Class representing the Archery mini-game.
+ * @brief The Archery mini-game.
  *
  * In this mini-game, players control a cursor affected by wind strength. The goal is to
  * move the cursor as close as possible to the target coordinates (0,0) by the end of the game.
  */
-class Archery : public MiniGame {
-public:
+struct Archery {
+    /// The strength of the wind for every turn of the run.
+    std::array<int8_t, 16> wind;
+    /// Index of the current turn's wind.
+    int8_t cursor;
+    int8_t length;
+    std::array<int8_t, 3> x;
+    std::array<int8_t, 3> y;
+    bool over;
+
+    void update(const State&);
+    State state() const;
+
     /**
      * @brief Advances the Archery game state to the next turn.
-     *
-     * This method implements the logic for progressing the Archery mini-game by one turn.
      */
-    void step(const std::array<Action, 3>&) override;
+    void step(const std::array<Action, 3>&);
+
+    bool is_terminal() const { return over; }
 
     /**
      * @brief Compute the medals earned by each players in once the Archery game is over.
      */
-    std::array<Medal, 3> score() const override;
+    std::array<Medal, 3> score() const;
 };
 
 /**
- * @brief Class representing the Roller Speed Skating mini-game.
+ * @brief The Roller Speed Skating mini-game.
  *
  * In this mini-game, players race on a cyclical track 10 spaces long. Each player has a risk
  * attribute ranging from 0 to 5. Players move forward based on the action chosen from a risk
  * order provided each turn.
+ *
+ * NOTE: Only the current turn's risk order is known, it is kept for the following turns.
  */
-class RollerSpeedSkating : public MiniGame {
-public:
+struct RollerSpeedSkating {
+    /// Index of each action in the risk order.
+    std::array<int8_t, 4> risk_index;
+    std::array<int16_t, 3> spaces_traveled;
+    /// The risk of each player, or their stun timer as a negative number.
+    std::array<int8_t, 3> risk;
+    int8_t turns_left;
+    bool over;
+
+    void update(const State&);
+    State state() const;
+
     /**
      * @brief Advances the Roller Speed Skating game state to the next turn.
-     *
-     * This method implements the logic for progressing the Roller Speed Skating mini-game by one turn.
      */
-    void step(const std::array<Action, 3>&) override;
+    void step(const std::array<Action, 3>&);
+
+    bool is_terminal() const { return over; }
 
     /**
      * @brief Compute the medals earned by each players in once the RollerSpeedSkating game is over.
      */
-    std::array<Medal, 3> score() const override;
+    std::array<Medal, 3> score() const;
 };
 
 /**
- * @brief Class representing the Diving mini-game.
+ * @brief The Diving mini-game.
  *
  * In this mini-game, players must match the sequence of directions given at the start of each run,
  * called the diving goal. Players earn points based on their combo multiplier, which increases
  * with consecutive matches.
  */
-class Diving : public MiniGame {
-public:
+struct Diving {
+    /// The diving goal.
+    std::array<Action, 16> goal;
+    /// Index of the current turn's direction in the goal.
+    int8_t cursor;
+    int8_t length;
+    std::array<int16_t, 3> points;
+    std::array<int8_t, 3> combo;
+    bool over;
+
+    void update(const State&);
+    State state() const;
+
     /**
      * @brief Advances the Diving game state to the next turn.
-     *
-     * This method implements the logic for progressing the Diving mini-game by one turn.
      */
-    void step(const std::array<Action, 3>&) override;
+    void step(const std::array<Action, 3>&);
+
+    bool is_terminal() const { return over; }
 
     /**
      * @brief Compute the medals earned by each players in once the Diving game is over.
      */
-    std::array<Medal, 3> score() const override;
+    std::array<Medal, 3> score() const;
 };
 
 /**
  * @brief Class representing the global Olymbits challenge.
+ *
+ * It is trivially copyable so that a search can clone it for each simulation.
  */
 class Olymbits {
 public:
@@ -221,10 +205,10 @@ public:
      * This method updates the state of each mini-game by calling their respective `step` methods.
      * It also increments the number of turns and updates the scores of each player when a mini-game ends.
      */
-    void step(std::array<Action, 3> action);
+    void step(const std::array<Action, 3>& action);
 
     /**
-     * @brief Returns the current state of each of the four mini-games.
+     * @brief Returns the registers of each of the four mini-games.
      */
     std::array<State, 4> state() const;
 
@@ -235,6 +219,20 @@ public:
         return m_player_id;
     }
 
+    /**
+     * @brief Returns the number of mini-games being played.
+     */
+    int n_games() const {
+        return m_ngames;
+    }
+
+    /**
+     * @brief Returns the number of turns played, counted by step() and turn_init().
+     */
+    int n_turns() const {
+        return m_nturns;
+    }
+
     /**
      * @brief Verifies if the Olymbits challenge has ended.
      *
@@ -245,25 +243,45 @@ public:
     }
 
     /**
-     * @brief Returns the score of each player in the Olymbits challenge.
+     * @brief Verifies if the runs of all the mini-games being played are over.
+     *
+     * The runs following a reset are unknown, so nothing more can be simulated.
      */
-    std::array<std::array<int, 4>, 3> score() const {
+    bool runs_over() const;
+
+    /**
+     * @brief Returns the score of each player in each mini-game.
+     */
+    const std::array<std::array<int, 4>, 3>& score() const {
         return m_scores;
     };
 
+    const HurdleRace& hurdle_race() const { return m_hurdle_race; }
+    const Archery& archery() const { return m_archery; }
+    const RollerSpeedSkating& skating() const { return m_skating; }
+    const Diving& diving() const { return m_diving; }
+
 private:
     int m_nturns{ 0 };
+    /// Number of turn inputs read, every one but the first following a turn played.
+    int m_ninputs{ 0 };
     int m_player_id{-1};
     int m_ngames{ 4 };
-    std::array<std::array<int, 4>, 3> m_scores;
-    std::array<std::unique_ptr<MiniGame>, 4> m_mini_games {
-        std::make_unique<HurdleRace>(),
-        std::make_unique<Archery>(),
-        std::make_unique<RollerSpeedSkating>(),
-        std::make_unique<Diving>()
-    };
+    std::array<std::array<int, 4>, 3> m_scores{};
+    HurdleRace m_hurdle_race{};
+    Archery m_archery{};
+    RollerSpeedSkating m_skating{};
+    Diving m_diving{};
+
+    /**
+     * @brief Call `f(game, index)' for each mini-game being played.
+     */
+    template<typename F>
+    void for_each_game(F&& f);
 };
 
+static_assert(std::is_trivially_copyable_v<Olymbits>);
+
 } // namespace olymbits
 
 
@@ -0,0 +1,149 @@
+#include "tables.h"
+
+#include <algorithm>
+
+namespace olymbits {
+
+namespace {
+    /// The costs of actions from their values, the best value being the lowest.
+    std::array<int, 4> regrets(std::array<int, 4> values) {
+        const int best = *std::min_element(values.begin(), values.end());
+        for (auto& v : values) {
+            v -= best;
+        }
+        return values;
+    }
+
+    /// Whether seq[begin, end) is the end of the first `length' elements of `cached'.
+    template<typename T, size_t N>
+    bool is_end_of(const std::array<T, N>& cached, int length,
+                   const std::array<T, N>& seq, int begin, int end) {
+        const int n = end - begin;
+        return n > 0 && n <= length
+            && std::equal(seq.begin() + begin, seq.begin() + end, cached.begin() + (length - n));
+    }
+}  // namespace
+
+void HurdleTable::reset(const HurdleRace& race) {
+    if (race.is_terminal() || (race.hurdles == m_hurdles && race.finish == m_finish)) {
+        return;
+    }
+    m_hurdles = race.hurdles;
+    m_finish = race.finish;
+
+    m_turns.assign(m_finish + 1, 0);
+    for (int pos = m_finish - 1; pos >= 0; --pos) {
+        int best = turns_after(pos, Action::LEFT);
+        for (auto a : {Action::UP, Action::RIGHT, Action::DOWN}) {
+            best = std::min(best, turns_after(pos, a));
+        }
+        m_turns[pos] = best;
+    }
+}
+
+int HurdleTable::turns_after(int position, Action a) const {
+    // Let the simulator move the player, so that the rules can't differ
+    HurdleRace race{};
+    race.hurdles = m_hurdles;
+    race.finish = m_finish;
+    race.position = { int8_t(position), 0, 0 };
+    race.step({ a, a, a });
+
+    const int pos = race.position[0];
+    return pos == m_finish ? 1 : 1 + race.stun_timer[0] + m_turns[pos];
+}
+
+std::array<int, 4> HurdleTable::costs(const HurdleRace& race, int player_id) const {
+    if (race.is_terminal() || race.stun_timer[player_id] > 0) {
+        return {0, 0, 0, 0};
+    }
+    const int pos = race.position[player_id];
+    return regrets({
+        turns_after(pos, Action::LEFT),
+        turns_after(pos, Action::UP),
+        turns_after(pos, Action::RIGHT),
+        turns_after(pos, Action::DOWN),
+    });
+}
+
+void ArcheryTable::reset(const Archery& archery) {
+    // The GPU only holds the winds to come, so the run solved on its first
+    // turn is still good as long as they are the end of its winds
+    if (archery.is_terminal()
+        || is_end_of(m_wind, m_length, archery.wind, archery.cursor, archery.length)) {
+        return;
+    }
+    m_wind = archery.wind;
+    m_length = archery.length;
+
+    m_distance.assign((m_length + 1) * side * side, 0);
+    for (int x = -20; x <= 20; ++x) {
+        for (int y = -20; y <= 20; ++y) {
+            m_distance[index(m_length, x, y)] = x * x + y * y;
+        }
+    }
+    for (int turn = m_length - 1; turn >= 0; --turn) {
+        const int w = m_wind[turn];
+        for (int x = -20; x <= 20; ++x) {
+            for (int y = -20; y <= 20; ++y) {
+                m_distance[index(turn, x, y)] = std::min({
+                    m_distance[index(turn + 1, std::max(x - w, -20), y)],
+                    m_distance[index(turn + 1, x, std::min(y + w, 20))],
+                    m_distance[index(turn + 1, std::min(x + w, 20), y)],
+                    m_distance[index(turn + 1, x, std::max(y - w, -20))],
+                });
+            }
+        }
+    }
+}
+
+std::array<int, 4> ArcheryTable::costs(const Archery& archery, int player_id) const {
+    if (archery.is_terminal()) {
+        return {0, 0, 0, 0};
+    }
+    const int turn = m_length - archery.length + archery.cursor;
+    const int w = m_wind[turn];
+    const int x = archery.x[player_id];
+    const int y = archery.y[player_id];
+    return regrets({
+        m_distance[index(turn + 1, std::max(x - w, -20), y)],
+        m_distance[index(turn + 1, x, std::min(y + w, 20))],
+        m_distance[index(turn + 1, std::min(x + w, 20), y)],
+        m_distance[index(turn + 1, x, std::max(y - w, -20))],
+    });
+}
+
+void DivingTable::reset(const Diving& diving) {
+    if (diving.is_terminal()
+        || is_end_of(m_goal, m_length, diving.goal, diving.cursor, diving.length)) {
+        return;
+    }
+    m_goal = diving.goal;
+    m_length = diving.length;
+
+    m_points.assign((m_length + 1) * (max_combo + 1), 0);
+    for (int turn = m_length - 1; turn >= 0; --turn) {
+        for (int combo = 0; combo <= max_combo; ++combo) {
+            m_points[index(turn, combo)] = std::max(
+                combo + 1 + m_points[index(turn + 1, combo + 1)],
+                m_points[index(turn + 1, 1)]);
+        }
+    }
+}
+
+std::array<int, 4> DivingTable::costs(const Diving& diving, int player_id) const {
+    if (diving.is_terminal()) {
+        return {0, 0, 0, 0};
+    }
+    const int turn = m_length - diving.length + diving.cursor;
+    const int combo = diving.combo[player_id];
+    const int match = combo + 1 + m_points[index(turn + 1, combo + 1)];
+    const int miss = m_points[index(turn + 1, 1)];
+
+    std::array<int, 4> points;
+    points.fill(-miss);
+    points[int(m_goal[turn])] = -match;
+    return regrets(points);
+}
+
+} // namespace olymbits
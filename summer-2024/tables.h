@@ -0,0 +1,110 @@
+#ifndef __TABLES_H__
+#define __TABLES_H__
+
+#include "olymbits.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace olymbits {
+
+/**
+ * @brief Exact single-player solutions of the mini-games whose runs are known in advance.
+ *
+ * Each table is solved by backward induction when a new run starts, then the
+ * cost of an action for any player is a constant time lookup. The GPU of
+ * Archery and Diving only shows the rest of the run, so their tables are kept
+ * while it is the end of the sequence they were solved for, and looked up
+ * from the turn it starts at. The cost of an
+ * action is how much worse its best outcome is than the best action's, in the
+ * unit of the mini-game, so the best actions cost 0.
+ *
+ * The opponents are ignored, except for the turns at which the run ends.
+ */
+
+/**
+ * @brief Fewest turns to reach the finish of a Hurdle Race from each position.
+ */
+class HurdleTable {
+public:
+    /**
+     * @brief Solve the run of `race' unless it is the one already solved.
+     */
+    void reset(const HurdleRace& race);
+
+    /**
+     * @brief Turns lost by each action of `player_id', 0 for all of them when stunned.
+     */
+    std::array<int, 4> costs(const HurdleRace& race, int player_id) const;
+
+private:
+    uint32_t m_hurdles{ 0 };
+    int m_finish{ -1 };
+    /// Turns to finish from each position, when not stunned.
+    std::vector<int> m_turns;
+
+    /// The turns to finish after playing `a' from `position'.
+    int turns_after(int position, Action a) const;
+};
+
+/**
+ * @brief Smallest final distance to the target of an Archery run from each turn and position.
+ */
+class ArcheryTable {
+public:
+    /**
+     * @brief Solve the run of `archery' unless its winds end the ones already solved.
+     */
+    void reset(const Archery& archery);
+
+    /**
+     * @brief Squared distance lost by each action of `player_id'.
+     */
+    std::array<int, 4> costs(const Archery& archery, int player_id) const;
+
+private:
+    static constexpr int side = 41;
+
+    std::array<int8_t, 16> m_wind{};
+    int m_length{ -1 };
+    /// Squared distance at the end of the run, by turn and position.
+    std::vector<int> m_distance;
+
+    static int index(int turn, int x, int y) {
+        return (turn * side + x + 20) * side + y + 20;
+    }
+};
+
+/**
+ * @brief Most points to be scored during a Diving run from each turn and combo.
+ */
+class DivingTable {
+public:
+    /**
+     * @brief Solve the run of `diving' unless its goal ends the one already solved.
+     */
+    void reset(const Diving& diving);
+
+    /**
+     * @brief Points lost by each action of `player_id'.
+     */
+    std::array<int, 4> costs(const Diving& diving, int player_id) const;
+
+private:
+    /// Combos above are counted as this one, which a run can't reach from 0.
+    static constexpr int max_combo = 32;
+
+    std::array<Action, 16> m_goal{};
+    int m_length{ -1 };
+    /// Points to be scored until the end of the run, by turn and combo.
+    std::vector<int> m_points;
+
+    static int index(int turn, int combo) {
+        return turn * (max_combo + 1) + std::min(combo, max_combo);
+    }
+};
+
+} // namespace olymbits
+
+#endif // __TABLES_H__
@@ -6,6 +6,9 @@
 #include <deque>
 #include <fstream>
 #include <iostream>
+#include <queue>
+#include <tuple>
+#include <vector>
 
 
 namespace tb {
@@ -53,14 +56,12 @@ Action Agent::best_action() const
  */
 void Agent::search(const Game& game)
 {
-    int max_depth = Max_depth;
-
-    bool found = depth_first_search(*ps++, max_depth);
-    --ps;
+    bool found = a_star_search(*ps);
 
     std::cerr << "Agent::search: "
         << (found ? "found " : "did not find a ")
-        << "solution" << std::endl;
+        << "solution of " << best_actions.size() << " turns, "
+        << n_expanded << " nodes expanded" << std::endl;
 }
 
 namespace {
@@ -70,18 +71,13 @@ size_t inline road_length()
     return prm->road[0].size();
 }
 
-int inline n_bikes(const State& s)
-{
-    return std::count(s.bikes.begin(), s.bikes.end(), 1);
-}
-
 /// The greatest lower bound for the number of turns in
-/// which it is possible to reach the end of the road
-int inline future_cost_lb(const State& s)
+/// which it is possible to reach the position `target'
+int inline future_cost_lb(const State& s, size_t target)
 {
     int p = s.pos, v = s.speed, t = 0;
 
-    while (p < road_length()) {
+    while (p < target) {
         v += 1;
         p += v;
         t += 1;
@@ -90,69 +86,107 @@ int inline future_cost_lb(const State& s)
     return t;
 }
 
+/// Same, for the end of the road
+int inline future_cost_lb(const State& s)
+{
+    return future_cost_lb(s, road_length());
+}
+
 bool inline is_past_holes(const State& s)
 {
     return s.pos >= last_hole;
 }
 
-int inline n_turns_left(const State& s)
+int inline n_turns_left(int turn)
 {
-    return Max_depth - s.turn;
+    return Max_depth - turn;
 }
 
-bool inline is_lost(const State& s)
+bool inline is_lost(const State& s, int turn)
 {
-    return future_cost_lb(s) > n_turns_left(s)
-        || n_bikes(s) < prm->min_bikes;
+    return future_cost_lb(s) > n_turns_left(turn)
+        || s.n_bikes() < prm->min_bikes;
 }
 
-} // namespace
-
-bool Agent::depth_first_search(const State& s, int max_depth) const
+/// Index of a state in the closed set, which only depends on its key
+size_t inline closed_index(const State& s)
 {
-    if (max_depth == 0) {
-        std::cerr << "\nReached max depth"
-            << std::endl;
-    }
+    return (size_t(s.pos) * (Max_speed + 1) + s.speed) * 16 + s.bikes;
+}
 
-    if (is_lost(s)) {
-        return false;
-    }
+/// A state reached by the search, with the way it was reached
+struct Node {
+    State state;
+    int turn;
+    int parent;
+    Action action;
+};
 
-    if (is_past_holes(s)) {
-        std::cerr << "\nAgent::dfs: state is past holes!"
-            << std::endl;
+std::vector<Node> nodes;
 
-        return true;
-    }
+} // namespace
 
-    Action actions[5] {
-        Action::None,
-        Action::None,
-        Action::None,
-        Action::None,
-        Action::None
+/**
+ * A* over the states, the cost being the number of turns.
+ *
+ * The heuristic is the number of turns needed to get past the
+ * last hole while speeding up every turn. It is consistent since
+ * an action changes the speed by one at most, so the first time
+ * a state is expanded it is reached in as few turns as possible
+ * and it goes into the closed set, a dense bitmap over the keys.
+ */
+bool Agent::a_star_search(const State& root)
+{
+    // Lowest estimated total cost first, then the deepest
+    using Entry = std::tuple<int, int, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    std::vector<bool> closed(road_length() * (Max_speed + 1) * 16, false);
+
+    best_actions.clear();
+    nodes.clear();
+    n_expanded = 0;
+
+    auto push = [&](const State& s, int g, int parent, Action a) {
+        nodes.push_back({ s, g, parent, a });
+        open.emplace(g + future_cost_lb(s, last_hole), -g, nodes.size() - 1);
     };
 
-    const auto& valid_actions = game.valid_actions(s);
-    std::copy(valid_actions.begin(), valid_actions.end(), &actions[0]);
-    bool found = false;
-
-    for (auto& a : actions) {
-        if (a == Action::None)
-            break;
-
-        game.apply(s, a, *ps);
-        found = depth_first_search(*ps++, max_depth - 1);
-        --ps;
+    if (is_lost(root, 0))
+        return false;
+    push(root, 0, -1, Action::None);
+
+    while (!open.empty()) {
+        const int ndx = std::get<2>(open.top());
+        open.pop();
+
+        const State s = nodes[ndx].state;
+        const int turn = nodes[ndx].turn;
+        if (closed[closed_index(s)])
+            continue;
+        closed[closed_index(s)] = true;
+
+        if (is_past_holes(s)) {
+            for (int n = ndx; nodes[n].parent != -1; n = nodes[n].parent)
+                best_actions.push_front(nodes[n].action);
+            return true;
+        }
 
-        if (found) {
-            best_actions.push_front(a);
-            break;
+        ++n_expanded;
+
+        State child;
+        const Actions actions = game.valid_actions(s);
+        for (int i = int(Action::Speed); i <= int(Action::Slow); ++i) {
+            const Action a = Action(i);
+            if (!(actions & action_bit(a)))
+                continue;
+            game.apply(s, a, child);
+            if (is_lost(child, turn + 1) || closed[closed_index(child)])
+                continue;
+            push(child, turn + 1, ndx, a);
         }
     }
 
-    return found;
+    return false;
 }
 
 } // namespace tb
@@ -15,11 +15,15 @@ public:
     void search(const Game& game);
     Action best_action() const;
 
+    /// Number of states expanded by the last search
+    int nodes_expanded() const { return n_expanded; }
+
 private:
     Game game;
     mutable int actions_out_count{ 0 };
+    int n_expanded{ 0 };
 
-    bool depth_first_search(const State& state, int max_depth) const;
+    bool a_star_search(const State& root);
 };
 
 } // namespace tb
@@ -3,6 +3,7 @@
 #include "tb.h"
 #include "agent.h"
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 #include <iostream>
@@ -86,7 +87,7 @@ int main(int argc, char* argv[])
         game.apply(state[count % 2], action, state[(count + 1) % 2]);
         ++count;
 
-        bool lost = std::count(state[count % 2].bikes.begin(), state[count % 2].bikes.end(), 1) < game.parameters()->min_bikes;
+        bool lost = state[count % 2].n_bikes() < game.parameters()->min_bikes;
         bool won = state[count % 2].pos >= game.get_road()[0].size() - 1;
 
         if (lost) {
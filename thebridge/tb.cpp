@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <iostream>
 #include <random>
@@ -16,11 +17,19 @@ namespace {
     tb::Params params{ };
     tb::State root_state{ };
 
-    std::array<std::vector<int>, 4> nex_holes{ };
+    /**
+     * Sparse table of the holes, lane_holes[k][p] being the lanes
+     * with a hole somewhere in [p, p + 2^k), as 4-bit masks.
+     */
+    std::vector<std::vector<uint8_t>> lane_holes{ };
     int last_hole = 0;
+    int longest_jump = 0;
+
+    /// Used to populate the lane_holes data
+    void init_lane_holes();
 
-    /// Used to populate the nex_holes data
-    void nex_holes_dists();
+    /// Length of the longest sequence of holes on a lane
+    int n_conseq_holes();
 
     void input_turn(std::istream& _in, tb::State& st);
 }
@@ -32,6 +41,9 @@ void Game::init(std::istream& _in)
 {
     std::string buf;
 
+    params = Params{ };
+    root_state = State{ };
+
     _in >> params.start_bikes
         >> params.min_bikes;
     _in.ignore();
@@ -49,55 +61,88 @@ void Game::init(std::istream& _in)
 
     input_turn(_in, root_state);
 
-    nex_holes_dists();
+    init_lane_holes();
+    longest_jump = n_conseq_holes();
 }
 
 namespace {
 
-    /**
- * Compute and store the distance from each position to its next hole.
- * This is needed for the move simulations.
- */
-    void nex_holes_dists()
+    void init_lane_holes()
     {
+        const size_t length = params.road[0].size();
+
+        lane_holes.assign(1, std::vector<uint8_t>(length, 0));
         last_hole = 0;
-        for (int i = 0; i < 4; ++i) {
-            auto holed_it = std::back_inserter(nex_holes[i]);
-            auto pos_it = params.road[i].begin();
-            while (pos_it != params.road[i].end()) {
-                auto holes_beg = std::find(pos_it, params.road[i].end(), Cell::Hole);
-                auto holes_end = std::find(holes_beg, params.road[i].end(), Cell::Bridge);
-                auto dist = std::distance(pos_it, holes_beg);
-                if (holes_beg == params.road[i].end()) {
-                    std::fill_n(holed_it, dist, Max_length);
-                }
-                else {
-                    std::generate_n(holed_it, dist, [n=dist]() mutable {return n--;});
-                    std::fill_n(holed_it, std::distance(holes_beg, holes_end), 0);
+        for (size_t p = 0; p < length; ++p) {
+            for (int i = 0; i < 4; ++i) {
+                if (params.road[i][p] == Cell::Hole) {
+                    lane_holes[0][p] |= 1 << i;
+                    last_hole = p + 1;
                 }
-                pos_it = holes_end;
             }
         }
+
+        for (size_t k = 1; (size_t(1) << k) <= length; ++k) {
+            const size_t half = size_t(1) << (k - 1);
+            auto& row = lane_holes.emplace_back(length, 0);
+            const auto& prev = lane_holes[k - 1];
+            for (size_t p = 0; p + 2 * half <= length; ++p) {
+                row[p] = prev[p] | prev[p + half];
+            }
+        }
+    }
+
+    /// The lanes with a hole in [first, last], no hole being past the road's end
+    inline unsigned holes(size_t first, size_t last)
+    {
+        last = std::min(last, params.road[0].size() - 1);
+        if (first > last)
+            return 0;
+
+        const int k = std::bit_width(last - first + 1) - 1;
+        return lane_holes[k][first] | lane_holes[k][last + 1 - (size_t(1) << k)];
+    }
+
+    int n_conseq_holes()
+    {
+        int res = 0;
+        for (int i = 0; i < 4; ++i) {
+            auto it = params.road[i].begin();
+            while (it != params.road[i].end())
+            {
+                it = std::find(it, params.road[i].end(), Cell::Hole);
+                auto n_conseq = std::distance(it, std::find(it, params.road[i].end(), Cell::Bridge));
+                res = n_conseq > res ? n_conseq : res;
+                it += n_conseq;
+            }
+        }
+        return res;
     }
 
     void input_turn(std::istream& _in, State& st)
     {
         int x, y, a; // NOTE: x-coord, y-coord, active-or-not
-        _in >> st.speed;
+        int speed;
+        _in >> speed;
         _in.ignore();
+        st.speed = speed;
 
         for (int i = 0; i < params.start_bikes; ++i) {
             _in >> x >> y >> a;
             _in.ignore();
-            st.bikes[y] = (a == 1);
+            st.bikes |= (a == 1) << y;
         }
         st.pos = x;
     }
 
+    // NOTE: A bike survives a move if its lane has no hole in
+    // [pos, pos + speed], except when jumping where only the
+    // landing cell counts. When changing lanes, the bike is also
+    // on its former lane over [pos, pos + speed - 1].
+
     inline void wait(State& s)
     {
-        for (int i = 0; i < 4; ++i)
-            s.bikes[i] &= nex_holes[i][s.pos] > s.speed;
+        s.bikes &= ~holes(s.pos, s.pos + s.speed);
         s.pos += s.speed;
     }
 
@@ -115,37 +160,27 @@ namespace {
 
     inline void jump(State& s)
     {
-        for (int i = 0; i < 4; ++i) {
-            s.bikes[i] &= params.road[i][s.pos + s.speed] != Cell::Hole;
-        }
+        s.bikes &= ~holes(s.pos + s.speed, s.pos + s.speed);
         s.pos += s.speed;
     }
 
     inline void up(State& s)
     {
-        if (s.bikes[0])
+        if (s.has_bike(0))
             return;
 
-        for (int i = 0; i < 3; ++i) {
-            s.bikes[i] = s.bikes[i + 1]
-                && nex_holes[i + 1][s.pos] >= s.speed
-                && nex_holes[i][s.pos] > s.speed;
-        }
-        s.bikes[3] = false;
+        const unsigned before = s.speed == 0 ? 0 : holes(s.pos, s.pos + s.speed - 1);
+        s.bikes = (s.bikes & ~before) >> 1 & ~holes(s.pos, s.pos + s.speed);
         s.pos += s.speed;
     }
 
     inline void down(State& s)
     {
-        if (s.bikes[3])
+        if (s.has_bike(3))
             return;
 
-        for (int i = 3; i > 0; --i) {
-            s.bikes[i] = s.bikes[i - 1]
-                && nex_holes[i - 1][s.pos] >= s.speed
-                && nex_holes[i][s.pos] > s.speed;
-        }
-        s.bikes[0] = false;
+        const unsigned before = s.speed == 0 ? 0 : holes(s.pos, s.pos + s.speed - 1);
+        s.bikes = (s.bikes & ~before) << 1 & ~holes(s.pos, s.pos + s.speed) & 0xF;
         s.pos += s.speed;
     }
 
@@ -182,84 +217,53 @@ void Game::apply(const State& state, Action a, State& s) const
 
     }
 
-    ++s.turn;
     if (s.pos >= params.road[0].size())
         s.pos = params.road[0].size() - 1;
 }
 
-int n_conseq_holes()
+Actions Game::valid_actions(const State& s) const
 {
-    int res = 0;
-    for (int i = 0; i < 4; ++i) {
-        auto it = params.road[i].begin();
-        while (it != params.road[i].end())
-        {
-            it = std::find(it, params.road[i].end(), Cell::Hole);
-            auto n_conseq = std::distance(it, std::find(it, params.road[i].end(), Cell::Bridge));
-            res = n_conseq > res ? n_conseq : res;
-            it += n_conseq;
-        }
-    }
-    return res;
-}
-
-const std::vector<Action>& Game::valid_actions(const State& s) const
-{
-    static const int longest_jump = n_conseq_holes();
-    static std::array<Action, 5> actions = {
-        Action::Speed, Action::Jump, Action::Up, Action::Down, Action::Slow
-    };
-    static std::vector<Action> ret;
-    ret.clear();
-    auto out = std::back_inserter(ret);
+    Actions ret = 0;
 
     // Speed is our first choice, but we cap the speed
     // to reduce number of candidates
-    if (s.speed < 2 * longest_jump)
-        out = Action::Speed;
+    if (s.speed < std::min<size_t>(2 * longest_jump, Max_speed))
+        ret |= action_bit(Action::Speed);
 
     if (s.speed == 0) {
         return ret;
     }
 
-    out = Action::Jump;
+    ret |= action_bit(Action::Jump);
 
     // Cannot go up if 0 is occupied
-    if (!s.bikes[0])
-        out = Action::Up;
+    if (!s.has_bike(0))
+        ret |= action_bit(Action::Up);
 
     // Cannot go down if 3 is occupied
-    if (!s.bikes[3])
-        out = Action::Down;
+    if (!s.has_bike(3))
+        ret |= action_bit(Action::Down);
 
     // Don't stop the bikes
     if (s.speed > 1)
-        out = Action::Slow;
+        ret |= action_bit(Action::Slow);
 
     return ret;
 }
 
 int Game::find_last_hole() const
 {
-    int _ret = 0;
-    for (int i=0; i<4; ++i) {
-        auto last_hole = std::distance(nex_holes[i].begin(),
-                                       std::find(nex_holes[i].begin(), nex_holes[i].end(), Max_length));
-        _ret = last_hole > _ret ? last_hole : _ret;
-    }
-    return _ret;
-
+    return last_hole;
 }
 
 void Game::show(std::ostream& _out, const State& s) const
 {
     const auto& road = params.road;
-    const auto& bikes = s.bikes;
 
     for (int i = 0; i < 4; ++i) {
         for (int j = 0; j < s.pos; ++j)
             _out << (road[i][j] == Cell::Hole ? '0' : '-');
-        _out << (s.bikes[i] ? 'B' : (road[i][s.pos] == Cell::Hole ? '0' : '-'));
+        _out << (s.has_bike(i) ? 'B' : (road[i][s.pos] == Cell::Hole ? '0' : '-'));
         for (int j = s.pos + 1; j < road[i].size(); ++j)
             _out << (road[i][j] == Cell::Hole ? '0' : '-');
         _out << '\n';
@@ -2,6 +2,7 @@
 #define TB_H_
 
 #include <array>
+#include <bit>
 #include <cstdint>
 #include <iosfwd>
 #include <vector>
@@ -11,6 +12,7 @@ namespace tb {
 constexpr size_t Max_length = 500;
 constexpr size_t Max_depth = 50;
 constexpr size_t Max_actions = 5;
+constexpr size_t Max_speed = 255;
 
 using Key = uint32_t;
 
@@ -18,8 +20,6 @@ enum class Cell { Bridge,
     Hole };
 using Road = std::array<std::vector<Cell>, 4>;
 
-using Bikes = std::array<bool, 4>;
-
 enum class Action {
     None = 0,
     Speed = 1,
@@ -38,16 +38,26 @@ struct Params {
     int min_bikes;
 };
 
+/// Set of actions, bit `int(a)' standing for the action `a'
+using Actions = uint8_t;
+
+constexpr Actions action_bit(Action a) { return Actions(1) << int(a); }
+
 /**
- * The mutable part of the game.
+ * The mutable part of the game, packed in 32 bits so that it
+ * is its own hash key.
  */
 struct State {
-    size_t pos{ 0 };
-    size_t speed{ 0 };
-    Bikes bikes { 0, 0, 0, 0 };
-    int turn{ 0 };
-    State* prev{ nullptr };
+    uint16_t pos{ 0 };
+    uint8_t speed{ 0 };
+    /// Bit i is set when there is a bike on lane i
+    uint8_t bikes{ 0 };
+
+    bool has_bike(int lane) const { return bikes >> lane & 1; }
+    int n_bikes() const { return std::popcount(bikes); }
+    Key key() const { return pos | speed << 16 | bikes << 24; }
 };
+static_assert(sizeof(State) == sizeof(Key));
 
 /**
  * Class implementing the game simulation.
@@ -62,8 +72,8 @@ public:
     /// Apply the action to cur_state and store the result in `next_state'
     void apply(const State& cur_state, Action action, State& next_state) const;
 
-    /// Generate the list of valid actions for `state'
-    const std::vector<Action>& valid_actions(const State& state) const;
+    /// The valid actions for `state'
+    Actions valid_actions(const State& state) const;
 
     /// Get the position of the last hole on the road
     int find_last_hole() const;
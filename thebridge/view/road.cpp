@@ -111,7 +111,7 @@ int main(int argc, char* argv[])
         viewer.reset_fg();
 
         for (int y=0; y<4; ++y) {
-            if (st->bikes[y]) {
+            if (st->has_bike(y)) {
                 Tile tile = road[y][st->pos] == Cell::Bridge
                     ? Tile::Bike
                     : Tile::BikeHole;